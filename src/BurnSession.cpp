@@ -0,0 +1,175 @@
+#include "BurnSession.h"
+#include <string.h>
+#include <stdio.h>
+#include <LittleFS.h>
+
+static const char *const SESSION_DIR = "/leda";
+static constexpr uint32_t SESSION_MAGIC = 0x5342434C; // "LCBS"
+static constexpr uint32_t SESSION_VERSION = 1;
+
+// Dateiformat: Kopf mit Summen, danach Ring aus LEDA_SESSION_HISTORY Sitzungen
+struct SessionFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    SessionTotals totals;
+};
+
+// Status -> Index in stateSeconds (0xFF = nicht erfasst)
+static uint8_t stateSlot(uint8_t state) {
+    switch (state) {
+        case 1: return 0;
+        case 2: return 1;
+        case 3: return 2;
+        case 4: return 3;
+        case 8: return 4;
+        default: return 0xFF;
+    }
+}
+
+static_assert(sizeof(ActiveSession::stateMs) / sizeof(uint32_t) == BurnSessionTracker::STATE_SLOTS, "ActiveSession passt nicht zu STATE_SLOTS");
+
+static uint32_t recordOffset(uint32_t number) {
+    return sizeof(SessionFileHeader) + ((number - 1) % LEDA_SESSION_HISTORY) * sizeof(BurnSession);
+}
+
+bool BurnSessionTracker::load(uint8_t channel) {
+    // Erster Kanal behält den bisherigen Dateinamen
+    if (channel == 0)
+        snprintf(_path, sizeof(_path), "%s/sessions.bin", SESSION_DIR);
+    else
+        snprintf(_path, sizeof(_path), "%s/sessions%u.bin", SESSION_DIR, (unsigned)channel + 1);
+
+    if (!LittleFS.begin()) return false;
+    File file = LittleFS.open(_path, "r");
+    if (!file) return false;
+
+    SessionFileHeader header;
+    bool ok = file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == SESSION_MAGIC && header.version == SESSION_VERSION;
+    if (ok) {
+        _totals = header.totals;
+        if (_totals.sessions > 0) {
+            file.seek(recordOffset(_totals.sessions));
+            if (file.read((uint8_t *)&_last, sizeof(_last)) != sizeof(_last))
+                _last = {};
+        }
+    }
+    file.close();
+    return ok;
+}
+
+BurnSessionTracker::Event BurnSessionTracker::update(const Data &data, uint32_t changed, uint32_t now) {
+    Event event = None;
+    // Der erste empfangene Status zählt auch ohne Änderung (gleich dem Warmstart-Wert)
+    const bool received = data.valid & DataField::bit(DataField::OvenStateNum);
+    if (received && ((changed & DataField::bit(DataField::OvenStateNum)) || _state == STATE_UNKNOWN)) {
+        const uint8_t state = data.oven_state_num.value;
+        if (_active) {
+            leaveState(now);
+            if (state == 8 && _state != 8 && _current.refuels < UINT8_MAX)
+                _current.refuels++;
+            if (!isBurning(state)) {
+                end(state, now);
+                event = Ended;
+            }
+        } else if (isBurning(state) && _state != STATE_UNKNOWN && !isBurning(_state)) {
+            begin(now);
+            event = Started;
+        }
+        _state = state;
+        _stateSince = now;
+    }
+
+    if (_active && (changed & DataField::bit(DataField::CombustionTemp)) && data.combustion_temp.value > _current.peakTemp)
+        _current.peakTemp = data.combustion_temp.value;
+    return event;
+}
+
+void BurnSessionTracker::begin(uint32_t now) {
+    _active = true;
+    _start = now;
+    _current = {};
+    _current.number = _totals.sessions + 1;
+    _current.startUptime = now / 1000;
+    _current.peakTemp = INT16_MIN;
+    memset(_stateMs, 0, sizeof(_stateMs));
+}
+
+void BurnSessionTracker::leaveState(uint32_t now) {
+    const uint8_t slot = stateSlot(_state);
+    if (slot != 0xFF)
+        _stateMs[slot] += now - _stateSince;
+}
+
+void BurnSessionTracker::end(uint8_t state, uint32_t now) {
+    _active = false;
+    _current.duration = (now - _start) / 1000;
+    _current.endState = state;
+    for (uint8_t i = 0; i < STATE_SLOTS; i++) {
+        const uint32_t seconds = _stateMs[i] / 1000;
+        _current.stateSeconds[i] = seconds > UINT16_MAX ? UINT16_MAX : seconds;
+    }
+
+    _totals.sessions = _current.number;
+    _totals.burnSeconds += _current.duration;
+    _totals.refuels += _current.refuels;
+    if (state == 97 || state == 99)
+        _totals.errorSessions++;
+    _last = _current;
+
+    // Schreiben übernimmt persist() auf loop
+    _pendingWrite.store(true, std::memory_order_release);
+}
+
+ActiveSession BurnSessionTracker::snapshot(uint32_t now) const {
+    ActiveSession saved = {};
+    if (!_active) return saved;
+    saved.session = _current;
+    saved.elapsedMs = now - _start;
+    memcpy(saved.stateMs, _stateMs, sizeof(saved.stateMs));
+    return saved;
+}
+
+bool BurnSessionTracker::resume(const ActiveSession &saved, uint8_t state, uint32_t now) {
+    // Inzwischen abgeschlossene oder fremde Sitzung (Verlauf weiter als der Stand)
+    if (saved.session.number == 0 || saved.session.number != _totals.sessions + 1 || !isBurning(state))
+        return false;
+    _active = true;
+    _current = saved.session;
+    _start = now - saved.elapsedMs;
+    // Modulo 2^32 gerechnet, damit millis() / 1000 - startUptime die Laufzeit ergibt
+    _current.startUptime = now / 1000 - saved.elapsedMs / 1000;
+    memcpy(_stateMs, saved.stateMs, sizeof(_stateMs));
+    _state = state;
+    _stateSince = now;
+    return true;
+}
+
+bool BurnSessionTracker::persist() {
+    if (!_pendingWrite.load(std::memory_order_acquire)) return false;
+    _pendingWrite.store(false, std::memory_order_relaxed);
+
+    if (!LittleFS.begin()) return false;
+    LittleFS.mkdir(SESSION_DIR);
+    File file = LittleFS.open(_path, LittleFS.exists(_path) ? "r+" : "w+");
+    if (!file) return false;
+
+    const BurnSession session = _last;
+    const SessionFileHeader header = {SESSION_MAGIC, SESSION_VERSION, _totals};
+    file.seek(recordOffset(session.number));
+    file.write((const uint8_t *)&session, sizeof(session));
+    file.seek(0);
+    file.write((const uint8_t *)&header, sizeof(header));
+    file.close();
+    return true;
+}
+
+bool BurnSessionTracker::history(uint8_t index, BurnSession &session) {
+    if (index >= LEDA_SESSION_HISTORY || index >= _totals.sessions) return false;
+    File file = LittleFS.open(_path, "r");
+    if (!file) return false;
+    file.seek(recordOffset(_totals.sessions - index));
+    bool ok = file.read((uint8_t *)&session, sizeof(session)) == sizeof(session);
+    file.close();
+    return ok;
+}
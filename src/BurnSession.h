@@ -0,0 +1,129 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include "DataModel.h"
+
+// Anzahl Sitzungen im Verlauf (Datei /leda/sessions.bin, ab dem zweiten Kanal sessions<n>.bin)
+#ifndef LEDA_SESSION_HISTORY
+    #define LEDA_SESSION_HISTORY 16
+#endif
+
+/**
+ * @brief Ein Abbrand vom Start bis zum Verlassen der Heizzustände.
+ */
+struct BurnSession {
+    uint32_t number;            // Laufende Nummer (1 = erste Sitzung)
+    uint32_t startUptime;       // Start in s seit Gerätestart (keine Uhrzeit verfügbar)
+    uint32_t duration;          // s
+    int16_t peakTemp;           // Max. Verbrennungstemperatur °C
+    uint8_t refuels;            // Wechsel nach "Nachlegen"
+    uint8_t endState;           // Status, mit dem die Sitzung endete
+    uint16_t stateSeconds[5];   // Zeit in Start, Anheizen (2), Anheizen (3), Heizbetrieb, Nachlegen
+    uint16_t reserved;
+};
+static_assert(sizeof(BurnSession) == 28, "Dateiformat: BurnSession muss 28 Byte groß sein");
+
+/**
+ * @brief Laufende Sitzung im Warmstart-Stand (DataSnapshot), number == 0: keine.
+ */
+struct ActiveSession {
+    BurnSession session;        // Nummer, Spitzentemperatur, Nachlegen bis zum Speichern
+    uint32_t elapsedMs;         // Laufzeit bis zum Speichern
+    uint32_t stateMs[5];        // Zeit je Status wie stateSeconds, ohne den laufenden Status
+};
+static_assert(sizeof(ActiveSession) == 52, "Dateiformat: ActiveSession muss 52 Byte groß sein");
+
+/**
+ * @brief Summen über alle Sitzungen (überstehen Neustarts).
+ */
+struct SessionTotals {
+    uint32_t sessions;
+    uint32_t burnSeconds;
+    uint32_t refuels;
+    uint32_t errorSessions;     // Ende mit Anheizfehler / Sicherheitsaus
+};
+
+/**
+ * @brief Erkennt Abbrände an den Wechseln von oven_state_num und führt Buch.
+ *
+ * update() läuft auf der KNX-Seite und rechnet nur im RAM. Am Sitzungsende wird das
+ * Ergebnis für persist() vorgemerkt, das auf loop die Datei schreibt: ein
+ * Datensatz im Ring plus die Summen, also ein Schreibvorgang je Abbrand.
+ * LittleFS verteilt die Schreibzugriffe (Wear-Levelling).
+ *
+ * Eine Sitzung beginnt nur beim beobachteten Wechsel aus einem bekannten,
+ * nicht heizenden Status. Läuft der Ofen beim Start bereits, wird die Sitzung
+ * aus dem Warmstart-Stand fortgesetzt (resume) oder gar nicht erfasst, statt
+ * mit falschem Beginn gezählt zu werden.
+ */
+class BurnSessionTracker {
+public:
+    enum Event : uint8_t {
+        None,
+        Started,
+        Ended
+    };
+
+    static constexpr uint8_t STATE_SLOTS = 5;
+
+    /**
+     * @brief Liest Summen und letzte Sitzung aus dem Dateisystem (setup).
+     * @param channel Kanal (0-basiert), bestimmt die Datei
+     */
+    bool load(uint8_t channel);
+
+    /**
+     * @brief Verarbeitet die Änderungen eines Frames (KNX-Seite).
+     * @param changed DataField-Bits der geänderten Felder
+     */
+    Event update(const Data &data, uint32_t changed, uint32_t now);
+
+    /**
+     * @brief Schreibt eine abgeschlossene Sitzung (loop), sonst ohne Aufwand.
+     */
+    bool persist();
+
+    /**
+     * @brief Stand der laufenden Sitzung für den Warmstart.
+     */
+    ActiveSession snapshot(uint32_t now) const;
+
+    /**
+     * @brief Setzt eine gespeicherte Sitzung nach dem Neustart fort (setup, nach load).
+     * Die Zeit ohne Strom zählt nicht zur Dauer.
+     * @param state Wiederhergestellter Ofenstatus
+     * @return false, wenn der Stand nicht zum Verlauf passt oder der Ofen nicht heizte
+     */
+    bool resume(const ActiveSession &saved, uint8_t state, uint32_t now);
+
+    /**
+     * @brief Liest Sitzung index (0 = neueste) aus dem Verlauf.
+     */
+    bool history(uint8_t index, BurnSession &session);
+
+    bool active() const { return _active; }
+    const BurnSession &current() const { return _current; }
+    const BurnSession &last() const { return _last; }
+    const SessionTotals &totals() const { return _totals; }
+
+    static bool isBurning(uint8_t state) { return (state >= 1 && state <= 4) || state == 8; }
+
+private:
+    BurnSession _current = {};
+    BurnSession _last = {};
+    SessionTotals _totals = {};
+    static constexpr uint8_t STATE_UNKNOWN = 0xFF;
+
+    bool _active = false;
+    uint8_t _state = STATE_UNKNOWN;     // Bis zum ersten empfangenen Status unbekannt
+    uint32_t _start = 0;
+    uint32_t _stateSince = 0;
+    uint32_t _stateMs[STATE_SLOTS] = {};
+    std::atomic<bool> _pendingWrite{false};
+    char _path[24] = "";
+
+    void begin(uint32_t now);
+    void end(uint8_t state, uint32_t now);
+    void leaveState(uint32_t now);
+};
@@ -1,205 +1,1528 @@
-#include "CANGatewayModule.h"
-
-// --- Hauptwerte ---
-#define KO_COMBUSTION_TEMP       0  // DPT 9.001 (Temperatur °C)
-#define KO_OVEN_STATE_NUM        1  // DPT 5.005 (Status Code)
-#define KO_AIRFLAP_ACT           2  // DPT 5.005 (Ist-Position %) damit ganze Zahlen angezeigt werden, wird als DPT 5.005 gesendet
-#define KO_AIRFLAP_TARGET        3  // DPT 5.005 (Soll-Position %) damit ganze Zahlen angezeigt werden, wird als DPT 5.005 gesendet
-#define KO_CRITICAL_TEMPERATURE  4  // DPT 1.005 (Alarm)
-
-// --- Erweiterte Status-Werte ---
-#define KO_OVEN_HEATED           5  // DPT 1.003 (Binär: Heizt/Heizt nicht)
-#define KO_EMBER_BED             6  // DPT 1.002 (Binär: Grundglut ja/nein)
-#define KO_HEATING_ERROR         7  // DPT 1.005 (Binär: Fehler ja/nein)
-#define KO_TREND                 8  // DPT 6.001 (Trend-Indikator)
-#define KO_OVEN_STATE_TXT        9  // DPT 13.001 (Text)
-
-// --- Statistiken ---
-#define KO_MAX_COMBUSTION_TEMP  10  // DPT 9.001 (°C)
-#define KO_SMOLDERING_TEMP      11  // DPT 9.001 (°C)
-#define KO_BURN_CYCLES          12  // DPT 7.001 (Zähler)
-#define KO_HEATING_ERROR_COUNT  13  // DPT 7.001 (Zähler)
-
-// --- Diagnose & Version ---
-#define KO_CONTROLLER_VERSION   14  // DPT 5.010 (Version)
-#define KO_IS_ONLINE            15  // DPT 1.011 (Status: Gateway erreichbar)
-#define KO_CONNECTION_LOST      16  // DPT 1.005 (Alarm: Timeout zum Ofen)
-
-#define KO_CAN_BUS_ERROR        17  // DPT 1.005 (Alarm: CAN-Bus-Fehler)
-
-
-CANGateway::CANGateway() {}
-
-void CANGateway::setup()
-{
-    // Initialisierung der CAN-Hardware über unsere Abstraktionsschicht
-    if (!CANInterface::begin()) {
-        logErrorP("CAN Hardware konnte nicht gestartet werden!");
-    } else {
-        logInfoP("CAN Hardware erfolgreich initialisiert (125k).");
-    }
-}
-
-void CANGateway::loop1() {
-    // 1. Alle verfügbaren CAN-Nachrichten verarbeiten
-    CANMessage msg;
-    while (CANInterface::available())
-    {
-        CANInterface::getNextMessage(msg);
-
-        // --- Debug Ausgaben ---
-        if (msg.len == 8) 
-        {
-            Serial.println("");
-            Serial.print("[CAN] Received CAN Message: ");
-            Serial.print("  id: "); Serial.println(msg.id, HEX);
-            Serial.print("  len: "); Serial.println(msg.len);
-            Serial.print("  data: ");
-
-            for(int x = 0; x < msg.len; x++) {
-                Serial.print(msg.data[x], DEC); 
-                Serial.print(" ");
-            }
-            Serial.println(""); // Zeilenumbruch nach den Daten
-        }
-
-        // --- Verarbeitung ---
-        // Schicht B (Protokoll) füllt Schicht C (Datenmodell)
-        LEDAProtocol::parseFrame(msg, _data);
-        
-        // Zeitstempel für "Online"-Check aktualisieren
-        _data.lastUpdateTimestamp = millis();
-    }
-
-    // 2. Nach der Verarbeitung der CAN-Nachrichten prüfen, was an KNX muss
-    syncDataToKNX();
-}
-
-
-void CANGateway::syncDataToKNX() {
-    uint32_t nun = millis();
-
-    // --- 2. VERBRENNUNGSTEMPERATUR (KO 1 - DPT 9.001) ---
-    float cTemp = (float)_data.combustion_temp.value;
-    float cLast = (float)_lastSentData.combustion_temp.value;
-    if ((Param_CombTempSendChg_1 && abs(cTemp - cLast) >= Param_CombTempAmount_1) || 
-         _data.combustion_temp.cycleElapsed(Param_CombTempCycle_1)) {
-        
-        knx.getGroupObject(KO_COMBUSTION_TEMP).value(cTemp, Dpt(9, 1));
-        _lastSentData.combustion_temp.value = _data.combustion_temp.value;
-        _data.combustion_temp.markAsSent();
-    }
-
-    // --- 3. MAX. VERBRENNUNGSTEMPERATUR (KO 2 - DPT 9.001) ---
-    float mTemp = (float)_data.max_combustion_temp.value;
-    float mLast = (float)_lastSentData.max_combustion_temp.value;
-    if ((Param_MaxCombTempSendChg_1 && abs(mTemp - mLast) >= Param_MaxCombTempAmount_1) || 
-         _data.max_combustion_temp.cycleElapsed(Param_MaxCombTempCycle_1)) {
-        
-        knx.getGroupObject(KO_MAX_COMBUSTION_TEMP).value(mTemp, Dpt(9, 1));
-        _lastSentData.max_combustion_temp.value = _data.max_combustion_temp.value;
-        _data.max_combustion_temp.markAsSent();
-    }
-
-    // --- 4. GLUTTEMPERATUR (KO 3 - DPT 9.001) ---
-    float sTemp = (float)_data.smoldering_temp.value;
-    float sLast = (float)_lastSentData.smoldering_temp.value;
-    if ((Param_SmoldTempSendChg_1 && abs(sTemp - sLast) >= Param_SmoldTempAmount_1) || 
-         _data.smoldering_temp.cycleElapsed(Param_SmoldTempCycle_1)) {
-        
-        knx.getGroupObject(KO_SMOLDERING_TEMP).value(sTemp, Dpt(9, 1));
-        _lastSentData.smoldering_temp.value = _data.smoldering_temp.value;
-        _data.smoldering_temp.markAsSent();
-    }
-
-    // --- 5. LUFTKLAPPE IST (KO 4 - DPT 5.005) ---
-    uint8_t fAct = _data.air_flap_act.value;
-    uint8_t fActLast = _lastSentData.air_flap_act.value;
-    if ((Param_AirActSendChg_1 && abs((int)fAct - (int)fActLast) >= Param_AirActAmount_1) || 
-         _data.air_flap_act.cycleElapsed(Param_AirActCycle_1)) {
-        
-        knx.getGroupObject(KO_AIRFLAP_ACT).value(fAct, Dpt(5, 5));
-        _lastSentData.air_flap_act.value = fAct;
-        _data.air_flap_act.markAsSent();
-    }
-
-    // --- 6. LUFTKLAPPE SOLL (KO 5 - DPT 5.005) ---
-    uint8_t fTrg = _data.air_flap_target.value;
-    uint8_t fTrgLast = _lastSentData.air_flap_target.value;
-    if ((Param_AirTrgSendChg_1 && abs((int)fTrg - (int)fTrgLast) >= Param_AirTrgAmount_1) || 
-         _data.air_flap_target.cycleElapsed(Param_AirTrgCycle_1)) {
-        
-        knx.getGroupObject(KO_AIRFLAP_TARGET).value(fTrg, Dpt(5, 5));
-        _lastSentData.air_flap_target.value = fTrg;
-        _data.air_flap_target.markAsSent();
-    }
-
-    // --- 7. OFEN STATUS CODE (KO 6 - DPT 5.005) ---
-    if (_data.oven_state_num.cycleElapsed(Param_StateNumCycle_1)) {
-        knx.getGroupObject(KO_OVEN_STATE_NUM).value(_data.oven_state_num.value, Dpt(5, 5));
-        _data.oven_state_num.markAsSent();
-    }
-
-    // --- 8. OFEN STATUS TEXT (KO 7 - DPT 16.000) ---
-    if (nun - _data.oven_state_text_lastSent >= (Param_StateTxtCycle_1 * 60000)) {
-        knx.getGroupObject(KO_OVEN_STATE_TXT).value(_data.oven_state_text, Dpt(16, 0));
-        _data.oven_state_text_lastSent = nun;
-    }
-
-    // --- 9. TREND (KO 8 - DPT 5.005) ---
-    int8_t trd = _data.trend.value;
-    int8_t trdLast = _lastSentData.trend.value;
-    if (abs((int)trd - (int)trdLast) >= Param_TrendAmount_1 || _data.trend.cycleElapsed(Param_TrendCycle_1)) {
-        knx.getGroupObject(KO_TREND).value((uint8_t)trd, Dpt(5, 5));
-        _lastSentData.trend.value = trd;
-        _data.trend.markAsSent();
-    }
-
-    // --- 10. OFEN GEHEIZT (KO 9 - DPT 1.001) ---
-    if (_data.oven_heated.cycleElapsed(Param_HeatedCycle_1)) {
-        knx.getGroupObject(KO_OVEN_HEATED).value(_data.oven_heated.value, Dpt(1, 1));
-        _data.oven_heated.markAsSent();
-    }
-
-    // --- 11. HEIZFEHLER (KO 10 - DPT 1.001) ---
-    if (_data.heating_error.updated) {
-        knx.getGroupObject(KO_HEATING_ERROR).value(_data.heating_error.value, Dpt(1, 1));
-        _data.heating_error.markAsSent();
-    }
-
-    // --- 12. ABBRANDZYKLEN (KO 11 - DPT 7.001) ---
-    if (_data.burn_cycles.updated) {
-        knx.getGroupObject(KO_BURN_CYCLES).value(_data.burn_cycles.value, Dpt(7, 1));
-        _data.burn_cycles.markAsSent();
-    }
-
-    // --- 13. FEHLERZÄHLER (KO 12 - DPT 7.001) ---
-    if (_data.heating_error_count.updated) {
-        knx.getGroupObject(KO_HEATING_ERROR_COUNT).value(_data.heating_error_count.value, Dpt(7, 1));
-        _data.heating_error_count.markAsSent();
-    }
-
-    // --- 14. VERSION (KO 13 - DPT 5.005) ---
-    if (_data.controller_version.updated) {
-        knx.getGroupObject(KO_CONTROLLER_VERSION).value(_data.controller_version.value, Dpt(5, 5));
-        _data.controller_version.markAsSent();
-    }
-
-    // --- 15. GLUTBETT (KO 14 - DPT 1.001) ---
-    if (_data.ember_bed.updated) {
-        knx.getGroupObject(KO_EMBER_BED).value(_data.ember_bed.value, Dpt(1, 1));
-        _data.ember_bed.markAsSent();
-    }
-
-    // --- 16. KRITISCHE TEMP ALARM (KO 15 - DPT 1.001) ---
-    if (_data.critical_temperature.updated) {
-        knx.getGroupObject(KO_CRITICAL_TEMPERATURE).value(_data.critical_temperature.value, Dpt(1, 1));
-        _data.critical_temperature.markAsSent();
-    }
-
-    // --- 17. CAN BUS FEHLER (KO 16 - DPT 1.001) ---
-    if (_data.can_bus_error.updated) {
-        knx.getGroupObject(KO_CAN_BUS_ERROR).value(_data.can_bus_error.value, Dpt(1, 1));
-        _data.can_bus_error.markAsSent();
-    }
-}
\ No newline at end of file
+#include "CANGatewayModule.h"
+#include "CanTrace.h"
+#include "CanCapture.h"
+#include "CycleGrid.h"
+#include "DataSnapshot.h"
+#include "LedaLog.h"
+#include "LedaProfile.h"
+#include "OvenStateText.h"
+#if LEDA_IDLE_ENABLED
+    #include <hardware/sync.h>
+    #include <pico/time.h>
+#endif
+
+// KO-Nummern je Kanal entsprechend LedaGateway.share.xml (relativ zu LedaChannel::koBase,
+// Kanal n beginnt bei LEDA_KoOffset + n * LEDA_KoBlockSize, beides vom Producer)
+#define KO_HEARTBEAT             0  // DPT 1.001
+// --- Hauptwerte ---
+#define KO_COMBUSTION_TEMP       1  // DPT 9.001 (Temperatur °C)
+#define KO_MAX_COMBUSTION_TEMP   2  // DPT 9.001 (°C)
+#define KO_SMOLDERING_TEMP       3  // DPT 9.001 (°C)
+#define KO_AIRFLAP_ACT           4  // DPT 5.005 (Ist-Position %) damit ganze Zahlen angezeigt werden, wird als DPT 5.005 gesendet
+#define KO_AIRFLAP_TARGET        5  // DPT 5.005 (Soll-Position %) damit ganze Zahlen angezeigt werden, wird als DPT 5.005 gesendet
+#define KO_OVEN_STATE_NUM        6  // DPT 5.005 (Status Code)
+#define KO_OVEN_STATE_TXT        7  // DPT 16.000 (Text)
+#define KO_TREND                 8  // DPT 5.005 (Trend-Indikator)
+
+// --- Erweiterte Status-Werte ---
+#define KO_OVEN_HEATED           9  // DPT 1.001 (Binär: Heizt/Heizt nicht)
+#define KO_HEATING_ERROR        10  // DPT 1.001 (Binär: Fehler ja/nein)
+
+// --- Statistiken ---
+#define KO_BURN_CYCLES          11  // DPT 7.001 (Zähler)
+#define KO_HEATING_ERROR_COUNT  12  // DPT 7.001 (Zähler)
+
+// --- Diagnose & Version ---
+#define KO_CONTROLLER_VERSION   13  // DPT 5.005 (Version)
+#define KO_EMBER_BED            14  // DPT 1.001 (Binär: Grundglut ja/nein)
+#define KO_CRITICAL_TEMPERATURE 15  // DPT 1.001 (Alarm)
+#define KO_CAN_BUS_ERROR        16  // DPT 1.001 (Alarm: CAN-Bus-Fehler)
+#define KO_IS_ONLINE            17  // DPT 1.011 (Status: Ofen erreichbar)
+#define KO_CONNECTION_LOST      18  // DPT 1.005 (Alarm: Timeout zum Ofen)
+
+// --- Statistik je Fenster ---
+#define KO_COMB_TEMP_MIN        19  // DPT 9.001 (°C)
+#define KO_COMB_TEMP_MAX        20  // DPT 9.001 (°C)
+#define KO_COMB_TEMP_MEAN       21  // DPT 9.001 (°C, zeitgewichtet)
+#define KO_COMB_TEMP_SLOPE      22  // DPT 9.002 (K pro Minute)
+#define KO_COMB_TEMP_ABOVE      23  // DPT 7.006 (Minuten über Schwelle)
+#define KO_AIRFLAP_MIN          24  // DPT 5.005 (%)
+#define KO_AIRFLAP_MAX          25  // DPT 5.005 (%)
+#define KO_AIRFLAP_MEAN         26  // DPT 5.005 (%, zeitgewichtet)
+
+// --- Abbrand-Sitzungen ---
+#define KO_SESSION_ACTIVE       27  // DPT 1.011 (Status: Abbrand läuft)
+#define KO_SESSION_COUNT        28  // DPT 7.001 (Zähler)
+#define KO_SESSION_DURATION     29  // DPT 7.006 (Minuten, letzter Abbrand)
+#define KO_SESSION_PEAK_TEMP    30  // DPT 9.001 (°C, letzter Abbrand)
+#define KO_SESSION_REFUELS      31  // DPT 5.010 (Nachlegen, letzter Abbrand)
+#define KO_SESSION_BURN_HOURS   32  // DPT 7.007 (Stunden, alle Abbrände)
+
+#define KO_PER_CHANNEL          33
+
+// --- CAN-Bus: einmal je Gerät, gilt für alle Kanäle am Bus (absolute Nummern vom Producer) ---
+#define KO_CAN_BUS_LOAD         LEDA_KoCanBusLoad       // DPT 5.001 (Buslast %)
+#define KO_CAN_BUS_STATE        LEDA_KoCanBusState      // DPT 5.010 (CanBusState: aktiv, Warnung, passiv, Bus-Off)
+#define KO_CAN_RX_OVERFLOWS     LEDA_KoCanRxOverflows   // DPT 7.001 (Zähler)
+
+// Kanal-Parameter: die ETS-Vorlage erzeugt je Kanal eigene Namen (_1, _2)
+#if LEDA_MAX_CHANNELS == 1
+    #define LEDA_PARAM(name, ch) Param_##name##_1
+#elif LEDA_MAX_CHANNELS == 2
+    #define LEDA_PARAM(name, ch) ((ch) == 0 ? Param_##name##_1 : Param_##name##_2)
+#else
+    #error "Die ETS-Vorlage enthält nur 2 Kanäle"
+#endif
+static_assert(LEDA_KoBlockSize >= KO_PER_CHANNEL, "KO-Block je Kanal in der ETS-Vorlage ist zu klein");
+
+// --- Sende-Tabelle: Feld -> Policy (Typ/DPT) -> KO, Priorität ---
+static constexpr SendEntry SEND_TABLE[] = {
+    makeSendEntry<SendPolicy<&Data::combustion_temp,      float,    9, 1>>(KO_COMBUSTION_TEMP,      SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::max_combustion_temp,  float,    9, 1>>(KO_MAX_COMBUSTION_TEMP,  SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::smoldering_temp,      float,    9, 1>>(KO_SMOLDERING_TEMP,      SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::air_flap_act,         uint8_t,  5, 5>>(KO_AIRFLAP_ACT,          SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::air_flap_target,      uint8_t,  5, 5>>(KO_AIRFLAP_TARGET,       SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::oven_state_num,       uint8_t,  5, 5>>(KO_OVEN_STATE_NUM,       SendPriority::Status),
+    makeSendEntry<TextSendPolicy>(KO_OVEN_STATE_TXT,       SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::trend,                uint8_t,  5, 5>>(KO_TREND,                SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::oven_heated,          bool,     1, 1>>(KO_OVEN_HEATED,          SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::heating_error,        bool,     1, 1>>(KO_HEATING_ERROR,        SendPriority::Alarm),
+    makeSendEntry<SendPolicy<&Data::burn_cycles,          uint16_t, 7, 1>>(KO_BURN_CYCLES,          SendPriority::Statistic),
+    makeSendEntry<SendPolicy<&Data::heating_error_count,  uint16_t, 7, 1>>(KO_HEATING_ERROR_COUNT,  SendPriority::Statistic),
+    makeSendEntry<SendPolicy<&Data::controller_version,   uint8_t,  5, 5>>(KO_CONTROLLER_VERSION,   SendPriority::Statistic),
+    makeSendEntry<SendPolicy<&Data::ember_bed,            bool,     1, 1>>(KO_EMBER_BED,            SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::critical_temperature, bool,     1, 1>>(KO_CRITICAL_TEMPERATURE, SendPriority::Alarm),
+    makeSendEntry<SendPolicy<&Data::can_bus_error,        bool,     1, 1>>(KO_CAN_BUS_ERROR,        SendPriority::Alarm),
+    makeSendEntry<SendPolicy<&Data::is_online,            bool,     1, 11>>(KO_IS_ONLINE,           SendPriority::Status),
+    makeSendEntry<SendPolicy<&Data::connection_lost,      bool,     1, 5>>(KO_CONNECTION_LOST,      SendPriority::Alarm),
+};
+static constexpr uint8_t SEND_COUNT = sizeof(SEND_TABLE) / sizeof(SEND_TABLE[0]);
+
+// --- Statistik-Tabelle: Signal, Kennwert -> KO, DPT ---
+// Wird in der Sendewarteschlange hinter der Sende-Tabelle geführt
+enum class StatValue : uint8_t { Min, Max, Mean, Slope, MinutesAbove };
+
+struct StatsEntry {
+    uint8_t signal;
+    StatValue value;
+    uint16_t ko;
+    uint16_t dptMain;
+    uint16_t dptSub;
+};
+
+static constexpr StatsEntry STATS_TABLE[] = {
+    {StatSignal::CombustionTemp, StatValue::Min,          KO_COMB_TEMP_MIN,   9, 1},
+    {StatSignal::CombustionTemp, StatValue::Max,          KO_COMB_TEMP_MAX,   9, 1},
+    {StatSignal::CombustionTemp, StatValue::Mean,         KO_COMB_TEMP_MEAN,  9, 1},
+    {StatSignal::CombustionTemp, StatValue::Slope,        KO_COMB_TEMP_SLOPE, 9, 2},
+    {StatSignal::CombustionTemp, StatValue::MinutesAbove, KO_COMB_TEMP_ABOVE, 7, 6},
+    {StatSignal::AirFlapAct,     StatValue::Min,          KO_AIRFLAP_MIN,     5, 5},
+    {StatSignal::AirFlapAct,     StatValue::Max,          KO_AIRFLAP_MAX,     5, 5},
+    {StatSignal::AirFlapAct,     StatValue::Mean,         KO_AIRFLAP_MEAN,    5, 5},
+};
+static constexpr uint8_t STATS_COUNT = sizeof(STATS_TABLE) / sizeof(STATS_TABLE[0]);
+
+// --- Sitzungs-Tabelle: Kennwert -> KO ---
+// Wird in der Sendewarteschlange hinter der Statistik-Tabelle geführt
+enum class SessionValue : uint8_t { Active, Count, Duration, PeakTemp, Refuels, BurnHours };
+
+struct SessionEntry {
+    SessionValue value;
+    uint16_t ko;
+};
+
+static constexpr SessionEntry SESSION_TABLE[] = {
+    {SessionValue::Active,    KO_SESSION_ACTIVE},
+    {SessionValue::Count,     KO_SESSION_COUNT},
+    {SessionValue::Duration,  KO_SESSION_DURATION},
+    {SessionValue::PeakTemp,  KO_SESSION_PEAK_TEMP},
+    {SessionValue::Refuels,   KO_SESSION_REFUELS},
+    {SessionValue::BurnHours, KO_SESSION_BURN_HOURS},
+};
+static constexpr uint8_t SESSION_COUNT = sizeof(SESSION_TABLE) / sizeof(SESSION_TABLE[0]);
+static constexpr uint8_t SESSION_OFFSET = SEND_COUNT + STATS_COUNT;
+
+// --- Bus-KOs: KO und Priorität je Eintrag (Reihenfolge = BusSlot) ---
+struct BusEntry {
+    uint16_t ko;
+    SendPriority priority;
+};
+namespace BusSlot {
+    enum : uint8_t { Load, State, Overflows, Count };
+}
+static constexpr BusEntry BUS_TABLE[BusSlot::Count] = {
+    {KO_CAN_BUS_LOAD,     SendPriority::Statistic},
+    {KO_CAN_BUS_STATE,    SendPriority::Status},
+    {KO_CAN_RX_OVERFLOWS, SendPriority::Statistic},
+};
+
+// Einträge je Kanal in der Sendewarteschlange (Kanal n ab n * CHANNEL_SLOTS),
+// die Bus-KOs folgen nach allen Kanälen
+static constexpr uint8_t CHANNEL_SLOTS = SESSION_OFFSET + SESSION_COUNT;
+static constexpr uint8_t BUS_SLOT_OFFSET = CHANNEL_SLOTS * LEDA_MAX_CHANNELS;
+static_assert(BUS_SLOT_OFFSET + BusSlot::Count <= KnxSendScheduler::CAPACITY, "Sendewarteschlange ist zu klein");
+#if LEDA_PROFILE_ENABLED
+static_assert(KO_PER_CHANNEL * LEDA_MAX_CHANNELS + BusSlot::Count <= LEDA_PROFILE_KO_COUNT, "LEDA_PROFILE_KO_COUNT ist zu klein");
+#endif
+
+// Telegrammzähler im Profil: kanalrelativ, unabhängig von LEDA_KoOffset/LEDA_KoBlockSize;
+// die Bus-KOs zählen hinter dem letzten Kanal
+static inline uint16_t profileKo(const LedaChannel &ch, uint8_t ko) {
+    return ch.index * KO_PER_CHANNEL + ko;
+}
+static inline uint16_t profileBusKo(uint8_t slot) {
+    return KO_PER_CHANNEL * LEDA_MAX_CHANNELS + slot;
+}
+
+// Zeitfenster, über das der Anlauf der Geräte verteilt wird
+static constexpr uint32_t STARTUP_SPREAD_MS = 10000;
+
+// Vom Gateway selbst bestimmte Felder: gültig ab Start, nicht im Warmstart
+static constexpr uint32_t LOCAL_FIELDS = DataField::bit(DataField::CanBusError) |
+                                         DataField::bit(DataField::IsOnline) |
+                                         DataField::bit(DataField::ConnectionLost);
+
+// Mindestabstand der Warmstart-Schreibvorgänge (zusätzlich vor einem Neustart)
+static constexpr uint32_t SNAPSHOT_INTERVAL_MS = 15 * 60000UL;
+
+// Abfrageintervall der MCP2515-Fehlerzähler (SPI-Zugriff, daher nicht je Frame)
+static constexpr uint32_t CAN_ERROR_SAMPLE_MS = 1000;
+
+// Überwachte CAN-IDs (ohne Kanal-Versatz)
+static constexpr uint16_t CAN_ID_MEASUREMENTS = 0x281;
+static constexpr uint16_t CAN_ID_STATUS       = 0x283;
+
+// Felder je CycleSlot
+static constexpr uint8_t CYCLE_FIELDS[CycleSlot::Count] = {
+    DataField::CombustionTemp,
+    DataField::MaxCombustionTemp,
+    DataField::SmolderingTemp,
+    DataField::AirFlapAct,
+    DataField::AirFlapTarget,
+    DataField::OvenStateNum,
+    DataField::OvenStateText,
+    DataField::Trend,
+    DataField::OvenHeated,
+};
+
+// Zyklus-Timer laufen in Ticks von 1024 ms, damit 16 Bit reichen (überlaufsicher bis ca. 9 h)
+static constexpr uint8_t CYCLE_TICK_SHIFT = 10;
+
+// Umkehrtabellen Feld -> Tabellenindex bzw. CycleSlot, Hysterese-Slot -> Tabellenindex
+// und Maske aller gesendeten Felder
+static constexpr uint8_t NO_ENTRY = 0xFF;
+static constexpr auto SEND_INDEX = []() {
+    struct {
+        uint8_t entry[DataField::Count];
+        uint8_t cycleSlot[DataField::Count];
+        uint8_t slotEntry[HysteresisSlot::Count];
+        uint32_t mask;
+    } index{};
+    for (uint8_t f = 0; f < DataField::Count; f++) index.entry[f] = index.cycleSlot[f] = NO_ENTRY;
+    for (uint8_t i = 0; i < SEND_COUNT; i++) {
+        index.entry[SEND_TABLE[i].field] = i;
+        index.mask |= DataField::bit(SEND_TABLE[i].field);
+        if (SEND_TABLE[i].slot != HysteresisSlot::None)
+            index.slotEntry[SEND_TABLE[i].slot] = i;
+    }
+    for (uint8_t s = 0; s < CycleSlot::Count; s++)
+        index.cycleSlot[CYCLE_FIELDS[s]] = s;
+    return index;
+}();
+
+// RAM-Budget des KNX-Sync (Sendezustand ohne Warteschlange)
+static_assert(sizeof(HysteresisState) <= 104, "Hysterese-Zustand überschreitet das RAM-Budget");
+static_assert(sizeof(DeadlineQueue<CycleSlot::Count, uint16_t>) <= 40, "Zyklus-Timer überschreiten das RAM-Budget");
+
+
+CANGateway::CANGateway() {}
+
+/**
+ * @brief Setzt die zuletzt gesendeten Werte auf die Standardwerte.
+ */
+void CANGateway::resetHysteresis(LedaChannel &ch) {
+    for (const SendEntry &entry : SEND_TABLE)
+        entry.commit(DEFAULT_VALUES, ch.hysteresis, 0);
+    // Platzhalter zählen nicht als Telegramm (keine Steigung daraus)
+    ch.hysteresis.sent = 0;
+    ch.deltaTimers = DeadlineQueue<HysteresisSlot::Count>();
+}
+
+/**
+ * @brief Warmstart: übernimmt den zuletzt gespeicherten Stand des Kanals.
+ *
+ * Die Werte stehen sofort in den KOs (ohne Telegramm, für Lese-Anfragen) und
+ * dienen als Vergleich für Änderungen und Hysterese. Gesendet wird ein Feld
+ * erst, wenn es seit dem Start vom Ofen kam (Data::valid).
+ */
+void CANGateway::restoreSnapshot(LedaChannel &ch) {
+    Data restored = DEFAULT_VALUES;
+    uint32_t known = 0;
+    int16_t lastSent[HysteresisSlot::Count];
+    ActiveSession session;
+    if (!DataSnapshot::load(ch.index, restored, known, lastSent, session)) return;
+
+    // Lokal bestimmte Felder gelten nicht über den Neustart hinweg
+    restored.can_bus_error = DEFAULT_VALUES.can_bus_error;
+    restored.is_online = DEFAULT_VALUES.is_online;
+    restored.connection_lost = DEFAULT_VALUES.connection_lost;
+    known &= ~LOCAL_FIELDS;
+    if (known & DataField::bit(DataField::OvenStateNum))
+        restored.oven_state_text = OvenStateText::get(restored.oven_state_num.value);
+    restored.dirty = 0;
+    restored.valid = LOCAL_FIELDS;
+    ch.ingest = restored;
+    ch.data = restored;
+    ch.known = known;
+
+    const uint32_t now = millis();
+    for (const SendEntry &entry : SEND_TABLE) {
+        if (!(known & DataField::bit(entry.field))) continue;
+        entry.write(ch.koBase + entry.ko, ch.data, false);
+        if (entry.slot != HysteresisSlot::None) {
+            ch.hysteresis.lastSent[entry.slot] = lastSent[entry.slot];
+            ch.hysteresis.lastSentAt[entry.slot] = now;
+        }
+    }
+    logInfoP("Kanal %u: Warmstart mit %u bekannten Werten", ch.index + 1, (unsigned)__builtin_popcount(known & SEND_INDEX.mask));
+
+    // Abbrand, der beim Speichern lief, fortsetzen (Verlauf muss vorher geladen sein)
+    if ((known & DataField::bit(DataField::OvenStateNum)) &&
+        ch.sessions.resume(session, restored.oven_state_num.value, now))
+        logInfoP("Kanal %u: Abbrand %u fortgesetzt", ch.index + 1, session.session.number);
+}
+
+/**
+ * @brief Schreibt den Stand aller Kanäle, die sich seit dem letzten Mal geändert haben.
+ */
+void CANGateway::saveSnapshots() {
+    for (uint8_t c = 0; c < _channelCount; c++) {
+        LedaChannel &ch = channel(c);
+        if (!ch.snapshotPending || ch.known == 0) continue;
+        if (DataSnapshot::save(c, ch.data, ch.known, ch.hysteresis, ch.sessions.snapshot(millis())))
+            ch.snapshotPending = false;
+        else
+            logErrorP("Kanal %u: Warmstart-Stand konnte nicht gespeichert werden", c + 1);
+    }
+    _snapshotAt = millis() + SNAPSHOT_INTERVAL_MS;
+}
+
+/**
+ * @brief Legt die Kanäle laut ETS im Pool an und ordnet ihre CAN-IDs zu.
+ *
+ * Einmalig beim Start; der Speicher ist für LEDA_MAX_CHANNELS reserviert.
+ */
+void CANGateway::setupChannels() {
+    uint8_t count = Param_ChannelCount;
+    _channelCount = (count < 1) ? 1 : (count > LEDA_MAX_CHANNELS ? LEDA_MAX_CHANNELS : count);
+
+    for (uint8_t c = 0; c < _channelCount; c++) {
+        LedaChannel &ch = *new (_channelPool[c]) LedaChannel(c, LEDA_KoOffset + c * LEDA_KoBlockSize);
+        ch.idOffset = LEDA_PARAM(CanIdOffset, c);
+        ch.ingest.valid = ch.data.valid = LOCAL_FIELDS;
+        resetHysteresis(ch);
+        for (uint8_t i = 0; i < LEDAProtocol::decodedIdCount(); i++) {
+            const uint16_t id = LEDAProtocol::decodedId(i) + ch.idOffset;
+            if (!_channelById.assign(id, c))
+                logErrorP("Kanal %u: CAN-ID 0x%03X ungültig oder bereits vergeben", c + 1, id);
+        }
+    }
+}
+
+/**
+ * @brief Startet den MCP2515 auf dem Kern, der danach allein per SPI auf ihn zugreift.
+ *
+ * Die ISR wird auf dem aufrufenden Kern angemeldet. noInterrupts() im Treiber
+ * sperrt nur diesen Kern; Senden und Fehlerabfrage aus ingest() dürfen daher
+ * nicht auf dem anderen Kern laufen als die ISR.
+ */
+void CANGateway::startCan() {
+    // Initialisierung der CAN-Hardware über unsere Abstraktionsschicht
+    // Ohne Diagnosemodus werden nur die dekodierten IDs aller Kanäle per Hardware-Filter angenommen
+    uint16_t ids[LEDA_MAX_CHANNELS * 8];
+    uint8_t idCount = 0;
+    for (uint8_t c = 0; c < _channelCount; c++)
+        for (uint8_t i = 0; i < LEDAProtocol::decodedIdCount() && idCount < sizeof(ids) / sizeof(ids[0]); i++)
+            ids[idCount++] = LEDAProtocol::decodedId(i) + channel(c).idOffset;
+    bool promiscuous = Param_CanPromiscuous;
+    if (!CANInterface::begin(promiscuous, ids, idCount)) {
+        logErrorP("CAN Hardware konnte nicht gestartet werden!");
+    } else {
+        logInfoP("CAN Hardware erfolgreich initialisiert (125k, %s, %u Kanäle).", promiscuous ? "alle IDs" : "gefiltert", _channelCount);
+    }
+
+    const uint32_t now = millis();
+    _canErrorSampleAt = now + CAN_ERROR_SAMPLE_MS;
+    _busTelemetry.begin(now, CANInterface::busBits());
+}
+
+void CANGateway::setup()
+{
+    setupChannels();
+#ifndef OPENKNX_DUALCORE
+    startCan();
+#endif
+
+    OvenStateText::setLanguage(Param_StateTextLanguage);
+    _sendQueue.begin(Param_SendRate, Param_SendBurst);
+
+    // Phasenlage aus der physikalischen Adresse: Geräte mit gleichen Zyklen
+    // senden nicht gleichzeitig, auch nicht nach gemeinsamem Netzausfall
+    _phaseSeed = (uint32_t)knx.individualAddress() * 2654435761UL;
+
+    // Anlauf: erst nach Startverzögerung + Geräteversatz senden, danach ohne Burst
+    uint32_t release = millis() + Param_StartupDelay * 1000UL + _phaseSeed % STARTUP_SPREAD_MS;
+    _sendQueue.hold(release);
+
+    uint32_t now = millis();
+
+    for (uint8_t c = 0; c < _channelCount; c++) {
+        LedaChannel &ch = channel(c);
+        loadSendConfig(ch);
+
+        // Summen und letzter Abbrand aus dem Dateisystem, vor dem Warmstart (laufende Sitzung)
+        if (ch.sessions.load(c))
+            logInfoP("Kanal %u: Abbrand-Verlauf geladen (%u Sitzungen)", c + 1, ch.sessions.totals().sessions);
+        restoreSnapshot(ch);
+
+        // Erste zyklische Sendungen auf das Phasenraster nach dem Anlauf legen
+        for (const SendEntry &entry : SEND_TABLE)
+            scheduleCycle(ch, entry.field, release);
+
+        // Verbindungsüberwachung: Timeout je ID, Heartbeat und Fehlerzähler über Termine
+        ch.liveness.watch(CAN_ID_MEASUREMENTS, LEDA_PARAM(Timeout281, c) * 1000UL, now);
+        ch.liveness.watch(CAN_ID_STATUS, LEDA_PARAM(Timeout283, c) * 1000UL, now);
+        ch.heartbeatMinutes = LEDA_PARAM(HeartbeatCycle, c);
+        if (ch.heartbeatMinutes)
+            _serviceTimers.schedule(ServiceTimer::Heartbeat + c, release);
+
+        // Statistik-Fenster (0 = aus)
+        ch.statsWindowMs = LEDA_PARAM(StatsWindow, c) * 60000UL;
+        ch.stats.signal[StatSignal::CombustionTemp].setThreshold(LEDA_PARAM(TempAboveThreshold, c));
+        if (ch.statsWindowMs) {
+            for (WindowStats &stats : ch.stats.signal)
+                stats.begin(now);
+            ch.stats.closeAt = now + ch.statsWindowMs;
+        }
+    }
+}
+
+void CANGateway::loop()
+{
+#ifndef OPENKNX_DUALCORE
+    // Ohne zweiten Kern laufen CAN-Seite und KNX-Seite nacheinander
+    ingest();
+#endif
+
+    // Gepufferte Debug-Ausgaben im Leerlauf ausgeben
+    LedaLog::drain();
+
+    // Aufgezeichnete Frames seitenweise ins Dateisystem schreiben
+    CanCapture::service();
+
+    // Neuen Stand der CAN-Seite übernehmen, dann prüfen, was an KNX muss
+    uint32_t now = millis();
+    for (uint8_t c = 0; c < _channelCount; c++) {
+        consumeSnapshot(channel(c), now);
+        consumeStats(channel(c));
+    }
+    if (_serviceTimers.due(now))
+        runServiceTimers(now);
+    for (uint8_t c = 0; c < _channelCount; c++)
+        syncDataToKNX(channel(c));
+    drainSendQueue();
+    if (_busStatusUpdates.pop(_busStatus))
+        syncBusStatus();
+
+    // Abgeschlossenen Abbrand speichern (höchstens ein Schreibvorgang je Sitzung)
+    for (uint8_t c = 0; c < _channelCount; c++)
+        channel(c).sessions.persist();
+
+    // Warmstart-Stand gedrosselt sichern
+    if ((int32_t)(now - _snapshotAt) >= 0)
+        saveSnapshots();
+}
+
+/**
+ * @brief Geplanter Neustart (z.B. nach ETS-Programmierung): Warmstart-Stand sichern.
+ *
+ * Bei Spannungsausfall (savePower) wird bewusst nicht geschrieben: LittleFS
+ * löscht und programmiert ganze Blöcke, das reicht die Restenergie nicht
+ * sicher. Es gilt dann der gedrosselt gesicherte Stand aus loop().
+ */
+void CANGateway::processBeforeRestart() {
+    saveSnapshots();
+}
+
+#ifdef OPENKNX_DUALCORE
+/**
+ * @brief Core 1 startet erst nach setup(): Kanäle und CAN-IDs stehen dann fest.
+ */
+void CANGateway::setup1() {
+    startCan();
+}
+
+void CANGateway::loop1() {
+    // Core 1 gehört allein der CAN-Seite, die Last des KNX-Stacks verzögert den Empfang nicht
+    ingest();
+#if LEDA_IDLE_ENABLED
+    idle();
+#endif
+}
+#endif
+
+#if LEDA_IDLE_ENABLED
+// Verbleibende Zeit bis deadline, höchstens limit (0 = fällig)
+static uint32_t untilDeadline(uint32_t deadline, uint32_t now, uint32_t limit) {
+    const int32_t remaining = (int32_t)(deadline - now);
+    if (remaining <= 0) return 0;
+    return (uint32_t)remaining < limit ? remaining : limit;
+}
+
+/**
+ * @brief Lässt Core 1 bis zum nächsten Frame oder Termin der CAN-Seite schlafen (WFE).
+ *
+ * Geweckt wird per Ereignis aus der MCP2515-ISR und von Core 0 (Replay),
+ * spätestens nach LEDA_IDLE_MAX_MS. Ein Ereignis zwischen Prüfung und WFE
+ * bleibt gespeichert, WFE kehrt dann sofort zurück. Ist noch etwas zu
+ * übergeben, wird nicht gewartet.
+ */
+void CANGateway::idle() {
+    if (CANInterface::available() || !_replayFrames.empty() || _busStatusChanged)
+        return;
+
+    const uint32_t now = millis();
+    uint32_t wait = untilDeadline(_canErrorSampleAt, now, LEDA_IDLE_MAX_MS);
+    for (uint8_t c = 0; c < _channelCount; c++) {
+        const LedaChannel &ch = channel(c);
+        // Stand wartet noch auf die KNX-Seite: weiter abfragen statt schlafen
+        if (ch.ingest.dirty) return;
+        if (ch.liveness.pending())
+            wait = untilDeadline(ch.liveness.nextDeadline(), now, wait);
+        if (ch.statsWindowMs)
+            wait = untilDeadline(ch.stats.closeAt, now, wait);
+    }
+    if (wait == 0) return;
+
+    best_effort_wfe_or_timeout(make_timeout_time_ms(wait));
+    _idleCount++;
+    _idleMs += millis() - now;
+}
+#endif
+
+/**
+ * @brief CAN-Seite: Frames dekodieren, Verbindung überwachen, Stand übergeben.
+ *
+ * Schreibt nur ingest und liveness der Kanäle. Die KNX-Seite erhält den Stand
+ * über publishSnapshot, ohne dass eine Seite auf die andere wartet.
+ */
+void CANGateway::ingest() {
+    // 1. Alle verfügbaren CAN-Nachrichten verarbeiten
+    CANMessage msg;
+    if (CANInterface::available())
+    {
+        LEDA_PROFILE_SCOPE(ProfileStage::Receive);
+        while (CANInterface::available())
+        {
+            CANInterface::getNextMessage(msg);
+
+            // --- Debug Ausgaben ---
+#if LEDA_LOG_ENABLED(LEDA_LOG_LEVEL_TRACE, LEDA_LOG_RAW)
+            if (LedaLog::active(LEDA_LOG_LEVEL_TRACE, LEDA_LOG_RAW)) {
+                char hex[3 * 8 + 1] = "";
+                for (uint8_t x = 0; x < msg.len && x < 8; x++)
+                    snprintf(hex + 3 * x, 4, "%02X ", msg.data[x]);
+                LedaLog::write(LEDA_LOG_LEVEL_TRACE, LEDA_LOG_RAW, "[CAN] Received id: %03X len: %u data: %s", (unsigned)msg.id, msg.len, hex);
+            }
+#endif
+
+            if (CanCapture::active())
+                CanCapture::record(msg, millis());
+
+            processFrame(msg);
+        }
+    }
+    while (_replayFrames.pop(msg))
+        processFrame(msg);
+
+    // Timeouts und Fehlerzähler nur prüfen, wenn ein Termin erreicht ist
+    uint32_t now = millis();
+    for (uint8_t c = 0; c < _channelCount; c++) {
+        LedaChannel &ch = channel(c);
+        if (ch.liveness.due(now) && ch.liveness.check(now))
+            updateOnlineState(ch);
+        if (ch.statsWindowMs && (int32_t)(now - ch.stats.closeAt) >= 0)
+            closeStatsWindow(ch, now);
+    }
+    if ((int32_t)(now - _canErrorSampleAt) >= 0)
+        sampleCanErrors(now);
+
+    // 2. Geänderten Stand an die KNX-Seite übergeben
+    for (uint8_t c = 0; c < _channelCount; c++)
+        publishSnapshot(channel(c));
+}
+
+/**
+ * @brief Übergibt ingest an die KNX-Seite, sobald diese den vorigen Stand abgeholt hat.
+ *
+ * Bis dahin sammeln sich die Änderungen weiter in ingest.dirty. Jede Änderung
+ * erreicht die KNX-Seite damit genau einmal, mit dem jeweils neuesten Wert.
+ */
+void CANGateway::publishSnapshot(LedaChannel &ch) {
+    if (ch.ingest.dirty == 0 || !ch.published.empty()) return;
+    ch.published.push(ch.ingest);
+    ch.ingest.dirty = 0;
+}
+
+/**
+ * @brief Übernimmt einen übergebenen Stand in data (KNX-Seite).
+ */
+void CANGateway::consumeSnapshot(LedaChannel &ch, uint32_t now) {
+    Data fresh;
+    if (!ch.published.pop(fresh)) return;
+    const uint32_t changed = fresh.dirty;
+    // Noch nicht synchronisierte Änderungen bleiben markiert
+    fresh.dirty |= ch.data.dirty;
+    ch.data = fresh;
+    ch.known |= fresh.valid & ~LOCAL_FIELDS;
+    if (changed & ~LOCAL_FIELDS)
+        ch.snapshotPending = true;
+    applyChanges(ch, changed, now);
+}
+
+/**
+ * @brief Führt die Abbrand-Sitzung mit den geänderten Feldern nach.
+ */
+void CANGateway::applyChanges(LedaChannel &ch, uint32_t changed, uint32_t now) {
+    // Im Benchmark keine Sitzungen erfassen, sonst würde der Trace gespeichert
+    if (!_dryRun)
+        updateSession(ch, changed, now);
+}
+
+/**
+ * @brief Ordnet einen Frame seinem Kanal zu und dekodiert ihn in dessen Datenmodell (CAN-Seite).
+ */
+bool CANGateway::processFrame(const CANMessage &msg) {
+    // Verteilung auf den Kanal über die ID-Tabelle (konstanter Aufwand)
+    LedaProfile::countFrame(msg.id);
+    const uint8_t c = msg.ext ? CanIdMap::NONE : _channelById.lookup(msg.id);
+    if (c >= _channelCount) {
+        LedaProfile::countUnknownId();
+        ledaLogInfo(LEDA_LOG_PROTO, "Unknown CAN ID: %X", (unsigned)msg.id);
+        return false;
+    }
+    LedaChannel &ch = channel(c);
+
+    // --- Verarbeitung ---
+    // Schicht B (Protokoll) füllt Schicht C (Datenmodell), mit den IDs ohne Kanal-Versatz
+    CANMessage local = msg;
+    local.id = msg.id - ch.idOffset;
+    FrameUpdate update;
+    bool known;
+    {
+        LEDA_PROFILE_SCOPE(ProfileStage::Decode);
+        known = LEDAProtocol::parseFrame(local, ch.ingest, &update);
+    }
+    if (!known)
+        LedaProfile::countUnknownSubtype();
+#if LEDA_ANALYZER_ENABLED
+    if (known && _analyzeLive && c == 0)
+        _analyzer.update(ch.ingest, update.present, update.changed, millis());
+#endif
+
+
+    // Statistik mit dem Empfangszeitpunkt, nicht erst bei der Übernahme auf der KNX-Seite
+    uint32_t now = millis();
+    if (known && ch.statsWindowMs)
+        updateStats(ch, update.changed, now);
+
+    // Empfang für den "Online"-Check melden
+    if (ch.liveness.onFrame(local.id, now))
+        updateOnlineState(ch);
+    return known;
+}
+
+/**
+ * @brief Übernimmt geänderte Werte in die Statistik-Fenster (CAN-Seite, konstanter Aufwand je Frame).
+ */
+void CANGateway::updateStats(LedaChannel &ch, uint32_t changed, uint32_t now) {
+    if (changed & DataField::bit(DataField::CombustionTemp))
+        ch.stats.signal[StatSignal::CombustionTemp].add(ch.ingest.combustion_temp.value, now);
+    if (changed & DataField::bit(DataField::AirFlapAct))
+        ch.stats.signal[StatSignal::AirFlapAct].add(ch.ingest.air_flap_act.value, now);
+}
+
+/**
+ * @brief Schließt die Statistik-Fenster ab und übergibt die Kennwerte an die KNX-Seite (CAN-Seite).
+ * Liegt das vorige Fenster noch in der Übergabe, wird das neue verworfen.
+ */
+void CANGateway::closeStatsWindow(LedaChannel &ch, uint32_t now) {
+    StatsResult result;
+    for (uint8_t s = 0; s < StatSignal::Count; s++)
+        result.signal[s] = ch.stats.signal[s].close(now);
+    if (ch.stats.closed.empty())
+        ch.stats.closed.push(result);
+    ch.stats.closeAt = now + ch.statsWindowMs;
+}
+
+/**
+ * @brief Übernimmt ein abgeschlossenes Fenster und merkt die Kennwerte zum Senden vor (KNX-Seite).
+ */
+void CANGateway::consumeStats(LedaChannel &ch) {
+    if (!ch.stats.closed.pop(ch.stats.result)) return;
+    for (uint8_t i = 0; i < STATS_COUNT; i++)
+        if (ch.stats.result.signal[STATS_TABLE[i].signal].valid)
+            requestSend(ch, SEND_COUNT + i, SendPriority::Statistic);
+}
+
+void CANGateway::writeStat(LedaChannel &ch, uint8_t index) {
+    const StatsEntry &entry = STATS_TABLE[index];
+    const WindowResult &result = ch.stats.result.signal[entry.signal];
+    float value = 0;
+    switch (entry.value) {
+        case StatValue::Min:          value = result.min; break;
+        case StatValue::Max:          value = result.max; break;
+        case StatValue::Mean:         value = result.mean; break;
+        case StatValue::Slope:        value = result.slopePerMinute; break;
+        case StatValue::MinutesAbove: value = result.secondsAbove / 60; break;
+    }
+    GroupObject &ko = knx.getGroupObject(ch.koBase + entry.ko);
+    if (entry.dptMain == 9)
+        ko.value(value, Dpt(entry.dptMain, entry.dptSub));
+    else if (entry.dptMain == 7)
+        ko.value((uint16_t)value, Dpt(entry.dptMain, entry.dptSub));
+    else
+        ko.value((uint8_t)(value + 0.5f), Dpt(entry.dptMain, entry.dptSub));
+}
+
+/**
+ * @brief Führt die Abbrand-Sitzung nach und merkt die KOs bei Beginn/Ende vor.
+ */
+void CANGateway::updateSession(LedaChannel &ch, uint32_t changed, uint32_t now) {
+    switch (ch.sessions.update(ch.data, changed, now)) {
+        case BurnSessionTracker::Started:
+            requestSend(ch, SESSION_OFFSET, SendPriority::Status);
+            // Laufende Sitzung bald in den Warmstart-Stand, damit sie einen Neustart übersteht
+            _snapshotAt = now;
+            break;
+        case BurnSessionTracker::Ended: {
+            const BurnSession &session = ch.sessions.last();
+            ledaLogInfo(LEDA_LOG_PROTO, "Kanal %u: Abbrand %u beendet: %u min, max. %d °C, %u x nachgelegt",
+                        ch.index + 1, session.number, session.duration / 60, session.peakTemp, session.refuels);
+            requestSend(ch, SESSION_OFFSET, SendPriority::Status);
+            for (uint8_t i = 1; i < SESSION_COUNT; i++)
+                requestSend(ch, SESSION_OFFSET + i, SendPriority::Statistic);
+            break;
+        }
+        case BurnSessionTracker::None:
+            break;
+    }
+}
+
+void CANGateway::writeSession(LedaChannel &ch, uint8_t index) {
+    const BurnSession &last = ch.sessions.last();
+    GroupObject &ko = knx.getGroupObject(ch.koBase + SESSION_TABLE[index].ko);
+    switch (SESSION_TABLE[index].value) {
+        case SessionValue::Active:    ko.value(ch.sessions.active(), Dpt(1, 11)); break;
+        case SessionValue::Count:     ko.value((uint16_t)ch.sessions.totals().sessions, Dpt(7, 1)); break;
+        case SessionValue::Duration:  ko.value((uint16_t)(last.duration / 60), Dpt(7, 6)); break;
+        case SessionValue::PeakTemp:  ko.value((float)last.peakTemp, Dpt(9, 1)); break;
+        case SessionValue::Refuels:   ko.value(last.refuels, Dpt(5, 10)); break;
+        case SessionValue::BurnHours: ko.value((uint16_t)(ch.sessions.totals().burnSeconds / 3600), Dpt(7, 7)); break;
+    }
+}
+
+/**
+ * @brief Überträgt den Zustand der Verbindungsüberwachung ins Datenmodell.
+ */
+void CANGateway::updateOnlineState(LedaChannel &ch) {
+    ch.ingest.set<&Data::is_online>(ch.liveness.online());
+    ch.ingest.set<&Data::connection_lost>(ch.liveness.lost());
+    // Läuft auf loop1, daher über den gepufferten Log
+    if (ch.liveness.lost())
+        ledaLogError(LEDA_LOG_PROTO, "Kanal %u: Verbindung zum Ofen verloren (Timeout)", ch.index + 1);
+    else if (ch.liveness.online())
+        ledaLogInfo(LEDA_LOG_PROTO, "Kanal %u: Ofen online", ch.index + 1);
+}
+
+/**
+ * @brief Arbeitet fällige Service-Termine ab (Heartbeat).
+ */
+void CANGateway::runServiceTimers(uint32_t now) {
+    while (_serviceTimers.due(now)) {
+        const uint8_t timer = _serviceTimers.pop();
+        LedaChannel &ch = channel(timer - ServiceTimer::Heartbeat);
+        if (!_dryRun) {
+            knx.getGroupObject(ch.koBase + KO_HEARTBEAT).value(true, Dpt(1, 1));
+            LedaProfile::countTelegram(profileKo(ch, KO_HEARTBEAT));
+        }
+        _serviceTimers.schedule(timer, now + ch.heartbeatMinutes * 60000UL);
+    }
+}
+
+/**
+ * @brief Liest die MCP2515-Fehlerzähler (CAN-Seite, SPI).
+ * Fehler bei Bus-Off oder Error-Passive (TEC/REC > 127), gilt für alle Kanäle am Bus.
+ */
+void CANGateway::sampleCanErrors(uint32_t now) {
+    _canErrorState = CANInterface::readErrorState();
+    bool error = _canErrorState.busOff() || _canErrorState.errorPassive();
+    if (_channelCount && error != channel(0).ingest.can_bus_error.value)
+        ledaLogError(LEDA_LOG_PROTO, "CAN Bus Fehler %s (TEC %u, REC %u, EFLG 0x%02X)", error ? "aktiv" : "behoben",
+                     _canErrorState.tec, _canErrorState.rec, _canErrorState.eflg);
+    for (uint8_t c = 0; c < _channelCount; c++)
+        channel(c).ingest.set<&Data::can_bus_error>(error);
+
+    // Busstatus wie die Kanäle: höchstens ein Stand unterwegs, der neueste gewinnt
+    if (_busTelemetry.sample(now, _canErrorState, CANInterface::busBits(), CANInterface::rxOverflows()))
+        _busStatusChanged = true;
+    if (_busStatusChanged && _busStatusUpdates.empty()) {
+        _busStatusUpdates.push(_busTelemetry.status());
+        _busStatusChanged = false;
+    }
+    _canErrorSampleAt = now + CAN_ERROR_SAMPLE_MS;
+}
+
+/**
+ * @brief Merkt Buslast, Fehlerzustand und Überläufe bei Änderung in der Sendewarteschlange vor.
+ * Die Buslast erst ab LEDA_CAN_BUSLOAD_HYSTERESIS Prozentpunkten Abstand zum gesendeten Wert.
+ */
+void CANGateway::syncBusStatus() {
+    const int16_t loadDelta = (int16_t)_busStatus.loadPercent - _busStatusSent.loadPercent;
+    const bool load = !_busStatusSentOnce || loadDelta >= LEDA_CAN_BUSLOAD_HYSTERESIS || loadDelta <= -LEDA_CAN_BUSLOAD_HYSTERESIS;
+    const bool state = !_busStatusSentOnce || _busStatus.state != _busStatusSent.state;
+    const bool overflows = !_busStatusSentOnce || _busStatus.overflows != _busStatusSent.overflows;
+    _busStatusSentOnce = true;
+    if (load) _busStatusSent.loadPercent = _busStatus.loadPercent;
+    if (state) _busStatusSent.state = _busStatus.state;
+    if (overflows) _busStatusSent.overflows = _busStatus.overflows;
+
+    if (load) requestSend(BusSlot::Load);
+    if (state) requestSend(BusSlot::State);
+    if (overflows) requestSend(BusSlot::Overflows);
+}
+
+/**
+ * @brief Schreibt ein Bus-KO mit dem zuletzt übernommenen Busstatus.
+ */
+void CANGateway::writeBusStatus(uint8_t slot) {
+    GroupObject &ko = knx.getGroupObject(BUS_TABLE[slot].ko);
+    switch (slot) {
+        case BusSlot::Load:
+            ko.value(_busStatus.loadPercent, Dpt(5, 1));
+            break;
+        case BusSlot::State:
+            ko.value(_busStatus.state, Dpt(5, 10));
+            break;
+        case BusSlot::Overflows:
+            ko.value(_busStatus.overflows, Dpt(7, 1));
+            break;
+    }
+    LedaProfile::countTelegram(profileBusKo(slot));
+}
+
+bool CANGateway::processCommand(const std::string cmd, bool diagnoseKo) {
+    if (cmd.rfind("leda replay ", 0) == 0) {
+        replayFrame(cmd.c_str() + 12);
+        return true;
+    }
+    if (cmd == "leda bench" || cmd.rfind("leda bench ", 0) == 0) {
+        uint32_t iterations = (cmd.length() > 11) ? strtoul(cmd.c_str() + 11, nullptr, 10) : 100;
+        runBenchmark(iterations > 0 ? iterations : 1);
+        return true;
+    }
+    if (cmd == "leda can") {
+        logInfoP("CAN Bus:");
+        logIndentUp();
+        logInfoP("Ring: %u/%u (Höchststand), %u Überläufe", CANInterface::rxHighWater(), CANInterface::rxCapacity(), CANInterface::rxOverflows());
+        logInfoP("Treiberpuffer: %u/%u (Höchststand)", CANInterface::rxDriverPeak(), LEDA_CAN_DRIVER_RX_BUFFER);
+        logInfoP("Fehlerzähler: TEC %u, REC %u, EFLG 0x%02X", _canErrorState.tec, _canErrorState.rec, _canErrorState.eflg);
+        static const char *const BUS_STATES[] = {"aktiv", "Warnung", "Error-Passive", "Bus-Off"};
+        const CanBusStatus &bus = _busTelemetry.status();
+        logInfoP("Buslast: %u %% (Fenster %u s%s), Zustand %s", bus.loadPercent, LEDA_CAN_BUSLOAD_WINDOW_MS / 1000,
+                 Param_CanPromiscuous ? "" : ", nur gefilterte IDs", BUS_STATES[bus.state]);
+        logInfoP("Überläufe: %u Ring, %u MCP2515", CANInterface::rxOverflows(), _busTelemetry.hardwareOverflows());
+#if LEDA_IDLE_ENABLED
+        logInfoP("Leerlauf loop1: %u ms in %u Pausen", _idleMs, _idleCount);
+#endif
+        for (uint8_t c = 0; c < _channelCount; c++) {
+            const Data &data = channel(c).data;
+            logInfoP("Ofen %u (ID-Versatz 0x%03X): %s", c + 1, channel(c).idOffset,
+                     data.is_online.value ? "online" : (data.connection_lost.value ? "Verbindung verloren" : "noch keine Daten"));
+        }
+        logIndentDown();
+        return true;
+    }
+    if (cmd == "leda knx") {
+        logInfoP("KNX Sendewarteschlange: %u vorgemerkt, %u gesendet, %u zusammengefasst",
+                 _sendQueue.queued(), _sendQueue.sent(), _sendQueue.coalesced());
+        return true;
+    }
+#if LEDA_CAPTURE_ENABLED
+    if (cmd.rfind("leda capture", 0) == 0) {
+        handleCapture(cmd.length() > 13 ? cmd.c_str() + 13 : "");
+        return true;
+    }
+#endif
+#if LEDA_ANALYZER_ENABLED
+    if (cmd.rfind("leda analyze", 0) == 0) {
+        handleAnalyze(cmd.length() > 13 ? cmd.c_str() + 13 : "");
+        return true;
+    }
+#endif
+    if (cmd == "leda session") {
+        for (uint8_t c = 0; c < _channelCount; c++)
+            showSessions(channel(c));
+        return true;
+    }
+#if LEDA_PROFILE_ENABLED
+    if (cmd.rfind("leda prof", 0) == 0) {
+        handleProfile(cmd.length() > 10 ? cmd.c_str() + 10 : "", diagnoseKo);
+        return true;
+    }
+#endif
+    if (cmd == "leda mem") {
+        showMemory();
+        return true;
+    }
+    if (cmd.rfind("leda log", 0) == 0) {
+        setLogMode(cmd.length() > 9 ? cmd.c_str() + 9 : "");
+        return true;
+    }
+    return false;
+}
+
+#if LEDA_CAPTURE_ENABLED
+/**
+ * @brief Steuert die Aufzeichnung ("leda capture start [kb]|stop|replay", ohne Argument: Status).
+ */
+void CANGateway::handleCapture(const char *args) {
+    if (strncmp(args, "start", 5) == 0) {
+        uint32_t sizeKb = strtoul(args + 5, nullptr, 10);
+        if (sizeKb == 0) sizeKb = 64;
+        if (sizeKb > 1024) sizeKb = 1024;
+        if (CanCapture::start(sizeKb))
+            logInfoP("Aufzeichnung gestartet (%u KB Ring)", sizeKb);
+        else
+            logErrorP("Aufzeichnung konnte nicht gestartet werden (LittleFS)");
+        return;
+    }
+    if (strcmp(args, "stop") == 0) {
+        CanCapture::stop();
+    } else if (strcmp(args, "replay") == 0) {
+        replayCapture();
+        return;
+    }
+    logInfoP("Aufzeichnung %s: %u Frames, %u Seiten, %u verworfen", CanCapture::active() ? "aktiv" : "gestoppt",
+             CanCapture::recorded(), CanCapture::pagesWritten(), CanCapture::dropped());
+}
+
+/**
+ * @brief Speist die Aufzeichnung in den Decoder ein (eigenes Datenmodell, kein KNX-Senden).
+ * Mit "leda log decode" werden die dekodierten Werte ausgegeben.
+ */
+void CANGateway::replayCapture() {
+    struct ReplayState {
+        Data data[LEDA_MAX_CHANNELS];
+        uint16_t idOffset[LEDA_MAX_CHANNELS];
+        const CanIdMap *channels;
+        uint8_t channelCount;
+        uint32_t decoded;
+        uint32_t unknown;
+        uint32_t first;
+        uint32_t last;
+    } state = {};
+    for (uint8_t c = 0; c < _channelCount; c++) {
+        state.data[c] = DEFAULT_VALUES;
+        state.idOffset[c] = channel(c).idOffset;
+    }
+    state.channels = &_channelById;
+    state.channelCount = _channelCount;
+
+    int32_t records = CanCapture::replay([](uint32_t millis, const CANMessage &msg, void *context) {
+        ReplayState &state = *(ReplayState *)context;
+        if (state.decoded + state.unknown == 0) state.first = millis;
+        state.last = millis;
+        const uint8_t c = msg.ext ? CanIdMap::NONE : state.channels->lookup(msg.id);
+        CANMessage local = msg;
+        if (c < state.channelCount) local.id -= state.idOffset[c];
+        if (c < state.channelCount && LEDAProtocol::parseFrame(local, state.data[c])) state.decoded++;
+        else state.unknown++;
+        LedaLog::drain();
+    }, &state);
+
+    if (records < 0) {
+        logErrorP("Keine Aufzeichnung vorhanden (oder Aufzeichnung läuft)");
+        return;
+    }
+    logInfoP("Replay: %d Frames über %u s, %u dekodiert, %u unbekannt",
+             records, (state.last - state.first) / 1000, state.decoded, state.unknown);
+}
+#endif
+
+#if LEDA_ANALYZER_ENABLED
+/**
+ * @brief Steuert die Analyse der unbekannten Bytes ("leda analyze live|stop|capture|reset").
+ * Ohne Argument wird der aktuelle Stand ausgegeben.
+ */
+void CANGateway::handleAnalyze(const char *args) {
+    if (strcmp(args, "live") == 0) {
+        _analyzeLive = true;
+        logInfoP("Analyse läuft auf empfangenen Frames");
+        return;
+    }
+    if (strcmp(args, "stop") == 0) {
+        _analyzeLive = false;
+    } else if (strcmp(args, "reset") == 0) {
+        _analyzer.reset();
+    }
+    #if LEDA_CAPTURE_ENABLED
+    else if (strcmp(args, "capture") == 0) {
+        // Aufzeichnung in einem eigenen Datenmodell auswerten (Frames des ersten Kanals)
+        _analyzeLive = false;
+        _analyzer.reset();
+        struct AnalyzeState {
+            Data data;
+            UnknownByteAnalyzer *analyzer;
+            const CanIdMap *channels;
+            uint16_t idOffset;
+        } state = {DEFAULT_VALUES, &_analyzer, &_channelById, _channelCount ? channel(0).idOffset : (uint16_t)0};
+        int32_t records = CanCapture::replay([](uint32_t millis, const CANMessage &msg, void *context) {
+            AnalyzeState &state = *(AnalyzeState *)context;
+            if (msg.ext || state.channels->lookup(msg.id) != 0) return;
+            CANMessage local = msg;
+            local.id -= state.idOffset;
+            FrameUpdate update;
+            if (LEDAProtocol::parseFrame(local, state.data, &update))
+                state.analyzer->update(state.data, update.present, update.changed, millis);
+        }, &state);
+        if (records < 0) {
+            logErrorP("Keine Aufzeichnung vorhanden (oder Aufzeichnung läuft)");
+            return;
+        }
+    }
+    #endif
+    showAnalysis();
+}
+
+void CANGateway::showAnalysis() {
+    logInfoP("Unbekannte Bytes (%u Statuswechsel, Korrelation in %%):", _analyzer.transitions());
+    logIndentUp();
+    logInfoP("%-9s %8s %6s %5s %5s %6s %6s %6s %6s", "Byte", "Samples", "Wechs%", "Werte", "Häuf.",
+             UnknownByteAnalyzer::referenceName(UnknownByteAnalyzer::RefCombustionTemp),
+             UnknownByteAnalyzer::referenceName(UnknownByteAnalyzer::RefAirFlapAct),
+             UnknownByteAnalyzer::referenceName(UnknownByteAnalyzer::RefOvenStateNum), "StatW%");
+    for (uint8_t i = 0; i < UnknownByteAnalyzer::UNKNOWN_COUNT; i++) {
+        const UnknownByteAnalyzer::ByteStats &s = _analyzer.stats(i);
+        const uint32_t samples = s.samples ? s.samples : 1;
+        const uint32_t changes = s.changes ? s.changes : 1;
+        logInfoP("%-9s %8u %6u %5u %5u %6d %6d %6d %6u", UnknownByteAnalyzer::name(i), s.samples,
+                 (uint32_t)((uint64_t)s.changes * 100 / samples), _analyzer.distinctValues(i), _analyzer.mostFrequent(i),
+                 _analyzer.correlation(i, UnknownByteAnalyzer::RefCombustionTemp),
+                 _analyzer.correlation(i, UnknownByteAnalyzer::RefAirFlapAct),
+                 _analyzer.correlation(i, UnknownByteAnalyzer::RefOvenStateNum),
+                 (uint32_t)((uint64_t)s.transitionChanges * 100 / changes));
+    }
+    logIndentDown();
+}
+#endif
+
+#if LEDA_PROFILE_ENABLED
+/**
+ * @brief Gibt die Hot-Path-Messung aus ("leda prof [reset]").
+ *
+ * Über das Diagnose-KO kommt eine Kurzfassung zurück, eine Zeile je Wert (max. 14 Zeichen).
+ */
+void CANGateway::handleProfile(const char *args, bool diagnoseKo) {
+    if (strcmp(args, "reset") == 0) {
+        LedaProfile::reset();
+        if (diagnoseKo)
+            openknx.console.writeDiagenoseKo("prof reset");
+        else
+            logInfoP("Messung zurückgesetzt");
+        return;
+    }
+
+    static const char *const stageNames[ProfileStage::Count] = {"rx", "dec", "post", "sync"};
+    const uint32_t perUs = LedaProfile::cyclesPerMicrosecond();
+    uint32_t seconds = (millis() - LedaProfile::since()) / 1000;
+    if (seconds == 0) seconds = 1;
+
+    uint32_t telegrams = 0;
+    for (uint16_t ko = 0; ko < _channelCount * KO_PER_CHANNEL; ko++)
+        telegrams += LedaProfile::telegrams(ko);
+    for (uint8_t slot = 0; slot < BusSlot::Count; slot++)
+        telegrams += LedaProfile::telegrams(profileBusKo(slot));
+
+    if (diagnoseKo) {
+        for (uint8_t s = 0; s < ProfileStage::Count; s++) {
+            const StageTiming &timing = LedaProfile::stage(s);
+            const uint32_t avg = timing.count ? (uint32_t)(timing.sum / timing.count) / perUs : 0;
+            openknx.console.writeDiagenoseKo("%s %u/%uus", stageNames[s], avg, timing.max / perUs);
+        }
+        uint16_t id;
+        uint32_t count;
+        for (uint8_t i = 0; LedaProfile::frames(i, id, count); i++)
+            openknx.console.writeDiagenoseKo("%03X %u/min", id, count * 60 / seconds);
+        openknx.console.writeDiagenoseKo("unk %u/%u", LedaProfile::unknownIds(), LedaProfile::unknownSubtypes());
+        openknx.console.writeDiagenoseKo("tg %u", telegrams);
+        return;
+    }
+
+    logInfoP("Hot-Path seit %u s (Takt %u MHz):", seconds, perUs);
+    logIndentUp();
+    logInfoP("%-5s %8s %8s %8s %8s", "Stufe", "Anzahl", "min us", "avg us", "max us");
+    for (uint8_t s = 0; s < ProfileStage::Count; s++) {
+        const StageTiming &timing = LedaProfile::stage(s);
+        const uint32_t avg = timing.count ? (uint32_t)(timing.sum / timing.count) : 0;
+        logInfoP("%-5s %8u %8u %8u %8u", stageNames[s], timing.count, timing.min / perUs, avg / perUs, timing.max / perUs);
+    }
+    uint16_t id;
+    uint32_t count;
+    for (uint8_t i = 0; LedaProfile::frames(i, id, count); i++)
+        logInfoP("ID 0x%03X: %u Frames (%u/min)", id, count, count * 60 / seconds);
+    if (LedaProfile::otherFrames())
+        logInfoP("Weitere IDs: %u Frames", LedaProfile::otherFrames());
+    logInfoP("Unbekannt: %u ID, %u Subtyp/zu kurz", LedaProfile::unknownIds(), LedaProfile::unknownSubtypes());
+    logInfoP("Telegramme: %u", telegrams);
+    logIndentUp();
+    for (uint16_t ko = 0; ko < _channelCount * KO_PER_CHANNEL; ko++)
+        if (LedaProfile::telegrams(ko))
+            logInfoP("KO %u (Kanal %u): %u", LEDA_KoOffset + ko / KO_PER_CHANNEL * LEDA_KoBlockSize + ko % KO_PER_CHANNEL,
+                     ko / KO_PER_CHANNEL + 1, LedaProfile::telegrams(ko));
+    for (uint8_t slot = 0; slot < BusSlot::Count; slot++)
+        if (LedaProfile::telegrams(profileBusKo(slot)))
+            logInfoP("KO %u (Bus): %u", BUS_TABLE[slot].ko, LedaProfile::telegrams(profileBusKo(slot)));
+    logIndentDown();
+    logIndentDown();
+}
+#endif
+
+/**
+ * @brief Gibt Summen, laufenden Abbrand und den Verlauf aus.
+ */
+void CANGateway::showSessions(LedaChannel &ch) {
+    const SessionTotals &totals = ch.sessions.totals();
+    logInfoP("Ofen %u: %u Abbrände, %u h Brenndauer, %u x nachgelegt, %u mit Fehler", ch.index + 1, totals.sessions,
+             totals.burnSeconds / 3600, totals.refuels, totals.errorSessions);
+    logIndentUp();
+    if (ch.sessions.active()) {
+        const BurnSession &current = ch.sessions.current();
+        logInfoP("Laufend: Nr. %u seit %u min, max. %d °C, %u x nachgelegt", current.number,
+                 (millis() / 1000 - current.startUptime) / 60, current.peakTemp, current.refuels);
+    }
+    logInfoP("%5s %8s %6s %5s %5s %5s %5s %5s %5s %5s", "Nr.", "Dauer", "Max°C", "Nachl", "Ende",
+             "Start", "Anh.2", "Anh.3", "Heiz", "Nachl");
+    BurnSession session;
+    for (uint8_t i = 0; ch.sessions.history(i, session); i++) {
+        const uint16_t *s = session.stateSeconds;
+        logInfoP("%5u %5umin %6d %5u %5u %5u %5u %5u %5u %5u", session.number, session.duration / 60, session.peakTemp,
+                 session.refuels, session.endState, s[0] / 60, s[1] / 60, s[2] / 60, s[3] / 60, s[4] / 60);
+    }
+    logIndentDown();
+}
+
+/**
+ * @brief Gibt den RAM-Bedarf von Datenmodell und Sendezustand aus.
+ */
+void CANGateway::showMemory() {
+    logInfoP("RAM CANGateway: %u Byte (%u von %u Kanälen belegt)", (unsigned)(sizeof(CANGateway)), _channelCount, LEDA_MAX_CHANNELS);
+    logIndentUp();
+    logInfoP("Kanal: %u Byte", (unsigned)(sizeof(LedaChannel)));
+    logIndentUp();
+    logInfoP("Data: %u Byte (%u Felder)", (unsigned)(sizeof(Data)), DataField::Count);
+    logInfoP("Hysterese: %u Byte (%u Felder)", (unsigned)(sizeof(HysteresisState)), HysteresisSlot::Count);
+    logInfoP("Zyklus-Timer: %u Byte (%u Felder)", (unsigned)(sizeof(LedaChannel::cycleTimers)), CycleSlot::Count);
+    logInfoP("Abstands-Timer: %u Byte (%u Felder)", (unsigned)(sizeof(LedaChannel::deltaTimers)), HysteresisSlot::Count);
+    logInfoP("Verbindungsüberwachung: %u Byte", (unsigned)(sizeof(LedaChannel::liveness)));
+    logInfoP("Statistik: %u Byte", (unsigned)(sizeof(LedaChannel::stats)));
+    logInfoP("Abbrand-Sitzungen: %u Byte", (unsigned)(sizeof(LedaChannel::sessions)));
+    logIndentDown();
+    logInfoP("CAN-ID-Zuordnung: %u Byte", (unsigned)(sizeof(_channelById)));
+    logInfoP("Sendewarteschlange: %u Byte", (unsigned)(sizeof(_sendQueue)));
+    logInfoP("Service-Termine: %u Byte", (unsigned)(sizeof(_serviceTimers)));
+    logInfoP("Übergabe CAN -> KNX: %u Byte je Kanal", (unsigned)(sizeof(LedaChannel::ingest) + sizeof(LedaChannel::published)));
+    logIndentDown();
+}
+
+/**
+ * @brief Schaltet Log-Level/Kategorien zur Laufzeit um ("leda log <raw|decode|proto|sync|all|off> [level]").
+ * Wirkt nur auf Ausgaben, die zur Compile-Zeit enthalten sind.
+ */
+void CANGateway::setLogMode(const char *args) {
+    static const struct { const char *name; uint8_t mask; } categories[] = {
+        {"raw", LEDA_LOG_RAW}, {"decode", LEDA_LOG_DECODE}, {"proto", LEDA_LOG_PROTO},
+        {"sync", LEDA_LOG_SYNC}, {"all", LEDA_LOG_ALL}, {"off", 0},
+    };
+
+    char name[8] = "";
+    unsigned level = LedaLog::level;
+    sscanf(args, "%7s %u", name, &level);
+    for (const auto &category : categories) {
+        if (strcmp(name, category.name) == 0) {
+            LedaLog::categories = category.mask;
+            LedaLog::level = (level > LEDA_LOG_LEVEL_TRACE) ? LEDA_LOG_LEVEL_TRACE : level;
+            break;
+        }
+    }
+    logInfoP("Log: Kategorien 0x%02X, Level %u (einkompiliert: 0x%02X, Level %u), %u verworfen",
+             LedaLog::categories, LedaLog::level, LEDA_LOG_CATEGORIES, LEDA_LOG_LEVEL, LedaLog::dropped());
+}
+
+void CANGateway::showHelp() {
+    openknx.console.printHelpLine("leda replay <frame>", "Inject candump frame (e.g. 281#2C01323204000010)");
+    openknx.console.printHelpLine("leda bench [n]", "Replay sample trace n times (dry run) and report timing");
+    openknx.console.printHelpLine("leda can", "Show CAN receive ring, error counters and online state per channel");
+    openknx.console.printHelpLine("leda knx", "Show KNX send queue statistics");
+#if LEDA_CAPTURE_ENABLED
+    openknx.console.printHelpLine("leda capture <cmd>", "Record raw frames to flash: start [kb]|stop|replay");
+#endif
+#if LEDA_ANALYZER_ENABLED
+    openknx.console.printHelpLine("leda analyze <cmd>", "Unknown bytes: live|stop|capture|reset, no arg: report");
+#endif
+    openknx.console.printHelpLine("leda session", "Show burn sessions per channel (totals, current, history in minutes)");
+#if LEDA_PROFILE_ENABLED
+    openknx.console.printHelpLine("leda prof [reset]", "Hot-path timing, frames per ID, telegrams per KO");
+#endif
+    openknx.console.printHelpLine("leda mem", "Show RAM usage of data model and send state");
+    openknx.console.printHelpLine("leda log <cat> [lvl]", "Debug log: raw|decode|proto|sync|all|off, level 1-4");
+}
+
+/**
+ * @brief Spielt einen einzelnen candump-Frame durch die komplette Pipeline (inkl. KNX-Senden).
+ * Der Frame wird auf der CAN-Seite wie ein empfangener verarbeitet.
+ */
+void CANGateway::replayFrame(const char *line) {
+    CANMessage msg;
+    if (!CanTrace::parseCandumpLine(line, msg)) {
+        logErrorP("Ungültiger Frame: %s", line);
+        return;
+    }
+    if (!_replayFrames.push(msg)) {
+        logErrorP("Frame verworfen, Einspeisung voll");
+        return;
+    }
+#if LEDA_IDLE_ENABLED
+    __sev();
+#endif
+    logInfoP("Frame 0x%03X eingespeist (Telegramme: leda knx)", (unsigned)msg.id);
+}
+
+/**
+ * @brief Misst Dekodierung und KNX-Sync mit dem eingebauten Referenz-Trace.
+ *
+ * Läuft auf dem ersten Kanal mit einer Kopie des Datenmodells ohne KOs zu
+ * beschreiben, der Zustand des Gateways bleibt unverändert. Dekodiert wird
+ * direkt in den Stand der KNX-Seite, die CAN-Seite läuft unterdessen weiter.
+ */
+void CANGateway::runBenchmark(uint32_t iterations) {
+    if (_channelCount == 0) return;
+    LedaChannel &ch = channel(0);
+    Data savedData = ch.data;
+    HysteresisState savedHysteresis = ch.hysteresis;
+    DeadlineQueue<CycleSlot::Count, uint16_t> savedTimers = ch.cycleTimers;
+    DeadlineQueue<HysteresisSlot::Count> savedDeltaTimers = ch.deltaTimers;
+    uint32_t savedTelegrams = _telegramCount;
+    uint32_t savedRequests = _sendRequests;
+
+    // Eigene, leere Warteschlange: vorgemerkte KOs der übrigen Kanäle und des
+    // Busses bleiben unberührt und gehen danach regulär auf den Bus
+    KnxSendScheduler savedQueue = _sendQueue;
+    _sendQueue = KnxSendScheduler();
+    _sendQueue.begin(Param_SendRate, Param_SendBurst);
+
+    ch.data = DEFAULT_VALUES;
+    resetHysteresis(ch);
+    _telegramCount = 0;
+    _sendRequests = 0;
+    _dryRun = true;
+
+    CANMessage msg;
+    uint32_t frames = 0;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (uint8_t f = 0; f < CanTrace::SAMPLE_COUNT; f++) {
+            CanTrace::toMessage(CanTrace::SAMPLE[f], msg);
+            FrameUpdate update;
+            if (LEDAProtocol::parseFrame(msg, ch.data, &update))
+                applyChanges(ch, update.changed, millis());
+            syncDataToKNX(ch);
+            drainSendQueue();
+            frames++;
+        }
+    }
+    uint32_t duration = micros() - start;
+    uint32_t telegrams = _telegramCount;
+    uint32_t requests = _sendRequests;
+
+    _dryRun = false;
+    ch.data = savedData;
+    ch.hysteresis = savedHysteresis;
+    ch.cycleTimers = savedTimers;
+    ch.deltaTimers = savedDeltaTimers;
+    _sendQueue = savedQueue;
+    _telegramCount = savedTelegrams;
+    _sendRequests = savedRequests;
+
+    if (duration == 0) duration = 1;
+    logInfoP("Benchmark: %u Frames in %u us", frames, duration);
+    logIndentUp();
+    logInfoP("%u ns/Frame", (uint32_t)((uint64_t)duration * 1000 / frames));
+    logInfoP("%u Frames/s", (uint32_t)((uint64_t)frames * 1000000 / duration));
+    logInfoP("%u Sendewünsche (requestSend)", requests);
+    logInfoP("%u davon gesendet (nach Zusammenfassung und Ratenbegrenzung)", telegrams);
+    logIndentDown();
+}
+
+
+/**
+ * @brief Liest die ETS-Parameter in die Sendekonfiguration je Feld.
+ * Felder ohne eigene Parameter werden bei jeder Änderung gesendet.
+ */
+void CANGateway::loadSendConfig(LedaChannel &ch) {
+    const uint8_t c = ch.index;
+    ch.sendOnChange = SEND_INDEX.mask;
+
+    configureField(ch, DataField::CombustionTemp,    LEDA_PARAM(CombTempSendChg, c),    LEDA_PARAM(CombTempCycle, c));
+    configureField(ch, DataField::MaxCombustionTemp, LEDA_PARAM(MaxCombTempSendChg, c), LEDA_PARAM(MaxCombTempCycle, c));
+    configureField(ch, DataField::SmolderingTemp,    LEDA_PARAM(SmoldTempSendChg, c),   LEDA_PARAM(SmoldTempCycle, c));
+    configureField(ch, DataField::AirFlapAct,        LEDA_PARAM(AirActSendChg, c),      LEDA_PARAM(AirActCycle, c));
+    configureField(ch, DataField::AirFlapTarget,     LEDA_PARAM(AirTrgSendChg, c),      LEDA_PARAM(AirTrgCycle, c));
+    configureField(ch, DataField::OvenStateNum,      false,                             LEDA_PARAM(StateNumCycle, c));
+    configureField(ch, DataField::OvenStateText,     false,                             LEDA_PARAM(StateTxtCycle, c));
+    configureField(ch, DataField::Trend,             true,                              LEDA_PARAM(TrendCycle, c));
+    configureField(ch, DataField::OvenHeated,        false,                             LEDA_PARAM(HeatedCycle, c));
+
+    configureDelta(ch, HysteresisSlot::CombustionTemp,    LEDA_PARAM(CombTempAmount, c),    LEDA_PARAM(CombTempSendMode, c),
+                   LEDA_PARAM(CombTempMinInterval, c),    LEDA_PARAM(CombTempMaxInterval, c));
+    configureDelta(ch, HysteresisSlot::MaxCombustionTemp, LEDA_PARAM(MaxCombTempAmount, c), LEDA_PARAM(MaxCombTempSendMode, c),
+                   LEDA_PARAM(MaxCombTempMinInterval, c), LEDA_PARAM(MaxCombTempMaxInterval, c));
+    configureDelta(ch, HysteresisSlot::SmolderingTemp,    LEDA_PARAM(SmoldTempAmount, c),   LEDA_PARAM(SmoldTempSendMode, c),
+                   LEDA_PARAM(SmoldTempMinInterval, c),   LEDA_PARAM(SmoldTempMaxInterval, c));
+    configureDelta(ch, HysteresisSlot::AirFlapAct,        LEDA_PARAM(AirActAmount, c),      LEDA_PARAM(AirActSendMode, c),
+                   LEDA_PARAM(AirActMinInterval, c),      LEDA_PARAM(AirActMaxInterval, c));
+    configureDelta(ch, HysteresisSlot::AirFlapTarget,     LEDA_PARAM(AirTrgAmount, c),      LEDA_PARAM(AirTrgSendMode, c),
+                   LEDA_PARAM(AirTrgMinInterval, c),      LEDA_PARAM(AirTrgMaxInterval, c));
+    configureDelta(ch, HysteresisSlot::Trend,             LEDA_PARAM(TrendAmount, c),       false, 0, 0);
+}
+
+void CANGateway::configureField(LedaChannel &ch, uint8_t field, bool onChange, uint8_t cycleMinutes) {
+    if (!onChange)
+        ch.sendOnChange &= ~DataField::bit(field);
+    ch.cycleMinutes[SEND_INDEX.cycleSlot[field]] = cycleMinutes;
+}
+
+void CANGateway::configureDelta(LedaChannel &ch, uint8_t slot, float amount, bool adaptive, uint8_t minSeconds, uint8_t maxSeconds) {
+    ch.hysteresis.amount[slot] = amount;
+    ch.hysteresis.minInterval[slot] = minSeconds;
+    ch.hysteresis.maxInterval[slot] = maxSeconds;
+    if (adaptive)
+        ch.hysteresis.adaptive |= 1 << slot;
+    else
+        ch.hysteresis.adaptive &= ~(1 << slot);
+}
+
+/**
+ * @brief Plant den nächsten zyklischen Sendezeitpunkt eines Feldes.
+ *
+ * Zyklische Sendungen liegen auf einem festen Raster je Feld (CycleGrid): Die
+ * Phase ergibt sich aus dem Geräteversatz plus der Position des Feldes in der
+ * Sende-Tabelle aller Kanäle. Nach einem Senden beginnt die Suche bei
+ * CycleGrid::afterSend().
+ *
+ * @param earliest Frühester Zeitpunkt (millis)
+ */
+void CANGateway::scheduleCycle(LedaChannel &ch, uint8_t field, uint32_t earliest) {
+    const uint8_t slot = SEND_INDEX.cycleSlot[field];
+    if (slot == NO_ENTRY) return;
+    if (ch.cycleMinutes[slot] == 0) {
+        ch.cycleTimers.cancel(slot);
+        return;
+    }
+    const uint32_t cycle = CycleGrid::cycleMs(ch.cycleMinutes[slot]);
+    const uint32_t position = ch.index * SEND_COUNT + SEND_INDEX.entry[field];
+    const uint32_t phase = CycleGrid::phase(_phaseSeed, position, SEND_COUNT * LEDA_MAX_CHANNELS, cycle);
+    const uint32_t deadline = CycleGrid::next(earliest, phase, cycle);
+    ch.cycleTimers.schedule(slot, (uint16_t)(deadline >> CYCLE_TICK_SHIFT));
+}
+
+/**
+ * @brief Merkt einen Eintrag (Index in der Kanal-Reihenfolge Sende-, Statistik-,
+ * Sitzungs-Tabelle) in der gemeinsamen Warteschlange vor.
+ */
+void CANGateway::requestSend(const LedaChannel &ch, uint8_t index, SendPriority priority) {
+    _sendRequests++;
+    _sendQueue.request(ch.index * CHANNEL_SLOTS + index, priority);
+}
+
+/**
+ * @brief Merkt ein Bus-KO (BusSlot) mit der Priorität aus BUS_TABLE vor.
+ */
+void CANGateway::requestSend(uint8_t busSlot) {
+    _sendRequests++;
+    _sendQueue.request(BUS_SLOT_OFFSET + busSlot, BUS_TABLE[busSlot].priority);
+}
+
+/**
+ * @brief Überträgt geänderte bzw. zyklisch fällige Werte eines Kanals an KNX.
+ *
+ * Besucht werden nur Felder mit gesetztem Dirty-Bit, abgelaufenem
+ * Zyklus-Timer oder abgelaufenem Abstands-Timer. Für jedes dieser Felder gilt
+ * dieselbe Regel: Zyklus fällig ODER (Senden bei Änderung UND evaluateDelta()).
+ */
+void CANGateway::syncDataToKNX(LedaChannel &ch) {
+    uint32_t now = millis();
+
+    uint32_t due = 0;
+    const uint16_t tick = now >> CYCLE_TICK_SHIFT;
+    while (ch.cycleTimers.due(tick))
+        due |= DataField::bit(CYCLE_FIELDS[ch.cycleTimers.pop()]);
+
+    // Felder, deren Mindest-/Höchstabstand oder Vorhersage-Drift erreicht ist, neu bewerten
+    uint32_t recheck = 0;
+    while (ch.deltaTimers.due(now))
+        recheck |= DataField::bit(SEND_TABLE[SEND_INDEX.slotEntry[ch.deltaTimers.pop()]].field);
+
+    uint32_t changed = ch.data.dirty;
+    if ((changed | due | recheck) == 0) return;
+    LEDA_PROFILE_SCOPE(ProfileStage::Sync);
+    ch.data.dirty = 0;
+
+    // Felder ohne Wert vom Ofen seit dem Start werden nicht gesendet, ihr Zyklus läuft weiter
+    for (uint32_t skipped = due & ~ch.data.valid; skipped; skipped &= skipped - 1) {
+        const uint8_t field = __builtin_ctz(skipped);
+        scheduleCycle(ch, field, CycleGrid::afterSend(now, ch.cycleMinutes[SEND_INDEX.cycleSlot[field]]));
+    }
+
+    uint32_t pending = (changed | due | recheck) & SEND_INDEX.mask & ch.data.valid;
+    while (pending) {
+        const uint8_t field = __builtin_ctz(pending);
+        pending &= pending - 1;
+
+        const uint8_t index = SEND_INDEX.entry[field];
+        const SendEntry &entry = SEND_TABLE[index];
+        const bool cyclic = due & DataField::bit(field);
+        bool send = cyclic ||
+                    (((changed | recheck) & ch.sendOnChange & DataField::bit(field)) &&
+                     (entry.slot == HysteresisSlot::None || evaluateDelta(ch, index, now)));
+        if (send) {
+            ledaLogDebug(LEDA_LOG_SYNC, "Kanal %u: KO %u vorgemerkt (%s)", ch.index + 1, ch.koBase + entry.ko,
+                         cyclic ? "Zyklus" : (recheck & DataField::bit(field)) ? "Termin" : "Änderung");
+            requestSend(ch, index, entry.priority);
+        }
+    }
+}
+
+/**
+ * @brief Send-on-Delta für ein Feld mit Hysterese-Slot.
+ *
+ * Gesendet wird, wenn der Wert um die Hysterese von dem abweicht, was der
+ * Empfänger annimmt (zuletzt gesendet bzw. im adaptiven Modus vorhergesagt),
+ * jedoch nicht vor Ablauf des Mindestabstands. Darunter geht ein abweichender
+ * Wert spätestens nach dem Höchstabstand raus. Zurückgestellte Entscheidungen
+ * werden über deltaTimers erneut bewertet, auch ohne neuen Frame.
+ *
+ * @return true, wenn jetzt gesendet werden soll
+ */
+bool CANGateway::evaluateDelta(LedaChannel &ch, uint8_t index, uint32_t now) {
+    const HysteresisState &hysteresis = ch.hysteresis;
+    const uint8_t slot = SEND_TABLE[index].slot;
+    const float deviation = SEND_TABLE[index].deviation(ch.data, hysteresis, now);
+    const uint32_t lastSentAt = hysteresis.lastSentAt[slot];
+    const uint32_t elapsed = now - lastSentAt;
+    // Abweichung in Zehnteln, für die Logausgabe (ohne float-printf)
+    [[maybe_unused]] const uint32_t tenths = (uint32_t)(deviation * 10 + 0.5f);
+
+    if (deviation >= hysteresis.threshold(slot)) {
+        const uint32_t minMs = hysteresis.minInterval[slot] * 1000UL;
+        if (elapsed >= minMs) return true;
+        ledaLogTrace(LEDA_LOG_SYNC, "Kanal %u: KO %u Abweichung %u.%u, Mindestabstand noch %u ms", ch.index + 1,
+                     ch.koBase + SEND_TABLE[index].ko, tenths / 10, tenths % 10, minMs - elapsed);
+        armDeltaTimer(ch, slot, lastSentAt + minMs);
+        return false;
+    }
+
+    // Empfänger zeigt (gerundet) einen anderen Wert: spätestens nach dem Höchstabstand senden
+    const uint32_t maxMs = hysteresis.maxInterval[slot] * 1000UL;
+    if (maxMs && deviation >= 0.5f) {
+        if (elapsed >= maxMs) {
+            ledaLogDebug(LEDA_LOG_SYNC, "Kanal %u: KO %u Höchstabstand erreicht (Abweichung %u.%u)", ch.index + 1,
+                         ch.koBase + SEND_TABLE[index].ko, tenths / 10, tenths % 10);
+            return true;
+        }
+        armDeltaTimer(ch, slot, lastSentAt + maxMs);
+    }
+    // Bleibt der Messwert stehen, läuft die Vorhersage weiter davon
+    const uint32_t drift = hysteresis.driftTime(slot, deviation);
+    if (drift)
+        armDeltaTimer(ch, slot, now + drift);
+    ledaLogTrace(LEDA_LOG_SYNC, "Kanal %u: KO %u unterdrückt (Abweichung %u.%u)", ch.index + 1,
+                 ch.koBase + SEND_TABLE[index].ko, tenths / 10, tenths % 10);
+    return false;
+}
+
+/**
+ * @brief Setzt den Abstands-Timer, sofern nicht schon ein früherer Termin ansteht.
+ */
+void CANGateway::armDeltaTimer(LedaChannel &ch, uint8_t slot, uint32_t deadline) {
+    if (!ch.deltaTimers.scheduled(slot) || (int32_t)(deadline - ch.deltaTimers.deadline(slot)) < 0)
+        ch.deltaTimers.schedule(slot, deadline);
+}
+
+/**
+ * @brief Sendet vorgemerkte KOs aller Kanäle und des Busses im Rahmen des Telegramm-Budgets, Alarme zuerst.
+ *
+ * Der Wert wird erst hier gelesen; mehrfach vorgemerkte KOs gehen daher nur
+ * einmal mit dem aktuellen Wert auf den Bus.
+ */
+void CANGateway::drainSendQueue() {
+    if (_sendQueue.idle()) return;
+
+    uint32_t now = millis();
+    uint8_t queued;
+    while ((queued = _sendQueue.next(now)) != KnxSendScheduler::NONE) {
+        if (queued >= BUS_SLOT_OFFSET) {
+            if (!_dryRun)
+                writeBusStatus(queued - BUS_SLOT_OFFSET);
+            _telegramCount++;
+            continue;
+        }
+
+        LedaChannel &ch = channel(queued / CHANNEL_SLOTS);
+        const uint8_t index = queued % CHANNEL_SLOTS;
+
+        // Statistik- und Sitzungs-Kennwerte: kein Zyklus, keine Hysterese
+        if (index >= SEND_COUNT) {
+            if (!_dryRun && index >= SESSION_OFFSET) {
+                writeSession(ch, index - SESSION_OFFSET);
+                LedaProfile::countTelegram(profileKo(ch, SESSION_TABLE[index - SESSION_OFFSET].ko));
+            } else if (!_dryRun) {
+                writeStat(ch, index - SEND_COUNT);
+                LedaProfile::countTelegram(profileKo(ch, STATS_TABLE[index - SEND_COUNT].ko));
+            }
+            _telegramCount++;
+            continue;
+        }
+
+        const SendEntry &entry = SEND_TABLE[index];
+        if (!_dryRun) {
+            entry.write(ch.koBase + entry.ko, ch.data, true);
+            LedaProfile::countTelegram(profileKo(ch, entry.ko));
+        }
+        _telegramCount++;
+        entry.commit(ch.data, ch.hysteresis, now);
+        const uint8_t slot = SEND_INDEX.cycleSlot[entry.field];
+        if (slot != NO_ENTRY)
+            scheduleCycle(ch, entry.field, CycleGrid::afterSend(now, ch.cycleMinutes[slot]));
+
+        // Neue Vorhersage: Drift-Prüfung frühestens nach dem Mindestabstand
+        if (entry.slot != HysteresisSlot::None) {
+            ch.deltaTimers.cancel(entry.slot);
+            uint32_t drift = ch.hysteresis.driftTime(entry.slot, 0);
+            const uint32_t minMs = ch.hysteresis.minInterval[entry.slot] * 1000UL;
+            if (drift && drift < minMs) drift = minMs;
+            if (drift && (ch.sendOnChange & DataField::bit(entry.field)))
+                ch.deltaTimers.schedule(entry.slot, now + drift);
+        }
+    }
+}
@@ -1,26 +1,121 @@
-#pragma once
-
-#include "OpenKNX.h"
-#include "DataModel.h"
-#include "CANInterface.h"
-#include "LEDAProtocol.h"
-#include <string>
-
-class CANGateway : public OpenKNX::Module
-{
-public:
-    CANGateway();
-
-    const std::string name() override { return "CANGateway"; }
-    const std::string version() override { return "0.0.1"; }
-
-    void setup() override;
-    void loop1() override;
-
-
-private:
-    Data _data;             // Enthält die aktuellen Werte vom CAN-Bus
-    Data _lastSentData;     // Enthält die Werte, die zuletzt erfolgreich an KNX gesendet wurden
-    void syncDataToKNX();
-
+#pragma once
+
+#include "OpenKNX.h"
+#include "DataModel.h"
+#include "CANInterface.h"
+#include "CanBusTelemetry.h"
+#include "LEDAProtocol.h"
+#include "DeadlineQueue.h"
+#include "LedaChannel.h"
+#include "CanIdMap.h"
+#include "SpscRing.h"
+#include "UnknownByteAnalyzer.h"
+#include <string>
+
+// Termine außerhalb der Sende-Tabelle (KNX-Seite); Heartbeat je Kanal
+namespace ServiceTimer {
+    enum : uint8_t {
+        Heartbeat,
+        Count = Heartbeat + LEDA_MAX_CHANNELS
+    };
+}
+
+class CANGateway : public OpenKNX::Module
+{
+public:
+    CANGateway();
+
+    const std::string name() override { return "CANGateway"; }
+    const std::string version() override { return "0.0.1"; }
+
+    void setup() override;
+    void loop() override;
+#ifdef OPENKNX_DUALCORE
+    void setup1() override;
+    void loop1() override;
+#endif
+    void processBeforeRestart() override;
+    bool processCommand(const std::string cmd, bool diagnoseKo) override;
+    void showHelp() override;
+
+
+private:
+    // Kanäle: Speicher für LEDA_MAX_CHANNELS, in Betrieb sind _channelCount (aus ETS)
+    alignas(LedaChannel) uint8_t _channelPool[LEDA_MAX_CHANNELS][sizeof(LedaChannel)];
+    uint8_t _channelCount = 0;
+    CanIdMap _channelById;                          // CAN-ID -> Kanal
+
+    KnxSendScheduler _sendQueue;                    // Ratenbegrenzung und Priorisierung der Telegramme (alle Kanäle)
+    uint32_t _phaseSeed = 0;                        // Geräteversatz für zyklisches Senden
+    DeadlineQueue<ServiceTimer::Count> _serviceTimers;  // Heartbeat
+    uint32_t _canErrorSampleAt = 0;                 // Nächste Abfrage der Fehlerzähler (CAN-Seite)
+    CanErrorState _canErrorState;                   // Zuletzt gelesene MCP2515-Fehlerzähler
+    CanBusTelemetry _busTelemetry;                  // Buslast, Fehlerzustand, Überläufe (CAN-Seite)
+    bool _busStatusChanged = false;                 // Geänderter Busstatus noch nicht übergeben (CAN-Seite)
+    SpscRing<CanBusStatus, 2> _busStatusUpdates;    // Busstatus an die KNX-Seite
+    CanBusStatus _busStatus;                        // KNX-Seite: zuletzt übernommener Busstatus
+    CanBusStatus _busStatusSent;                    // KNX-Seite: zuletzt zum Senden vorgemerkter Busstatus
+    bool _busStatusSentOnce = false;
+#if LEDA_IDLE_ENABLED
+    uint32_t _idleCount = 0;                        // Pausen von loop1
+    uint32_t _idleMs = 0;                           // Geschlafene Zeit von loop1
+#endif
+    SpscRing<CANMessage, 4> _replayFrames;          // Von der Konsole eingespeiste Frames (Core 0) an loop1
+#if LEDA_ANALYZER_ENABLED
+    UnknownByteAnalyzer _analyzer;                  // Auswertung der unbekannten Bytes (erster Kanal)
+    bool _analyzeLive = false;
+#endif
+    bool _dryRun = false;           // Benchmark: KOs werden nicht beschrieben
+    uint32_t _telegramCount = 0;    // Anzahl erzeugter KNX-Telegramme
+    uint32_t _sendRequests = 0;     // Anzahl Sendewünsche (requestSend), vor Zusammenfassung und Ratenbegrenzung
+    uint32_t _snapshotAt = 0;       // Frühester nächster Warmstart-Schreibvorgang
+
+    LedaChannel &channel(uint8_t index) { return *reinterpret_cast<LedaChannel *>(_channelPool[index]); }
+    void setupChannels();
+
+    void startCan();
+    void ingest();
+#if LEDA_IDLE_ENABLED
+    void idle();
+#endif
+    bool processFrame(const CANMessage &msg);
+    void updateOnlineState(LedaChannel &ch);
+    void sampleCanErrors(uint32_t now);
+    void syncBusStatus();
+    void writeBusStatus(uint8_t slot);
+    void publishSnapshot(LedaChannel &ch);
+    void consumeSnapshot(LedaChannel &ch, uint32_t now);
+    void applyChanges(LedaChannel &ch, uint32_t changed, uint32_t now);
+    void runServiceTimers(uint32_t now);
+    void updateStats(LedaChannel &ch, uint32_t changed, uint32_t now);
+    void closeStatsWindow(LedaChannel &ch, uint32_t now);
+    void consumeStats(LedaChannel &ch);
+    void writeStat(LedaChannel &ch, uint8_t index);
+    void updateSession(LedaChannel &ch, uint32_t changed, uint32_t now);
+    void writeSession(LedaChannel &ch, uint8_t index);
+    void requestSend(const LedaChannel &ch, uint8_t index, SendPriority priority);
+    void requestSend(uint8_t busSlot);
+    void syncDataToKNX(LedaChannel &ch);
+    bool evaluateDelta(LedaChannel &ch, uint8_t index, uint32_t now);
+    void armDeltaTimer(LedaChannel &ch, uint8_t slot, uint32_t deadline);
+    void drainSendQueue();
+    void scheduleCycle(LedaChannel &ch, uint8_t field, uint32_t earliest);
+    void loadSendConfig(LedaChannel &ch);
+    void configureField(LedaChannel &ch, uint8_t field, bool onChange, uint8_t cycleMinutes);
+    void configureDelta(LedaChannel &ch, uint8_t slot, float amount, bool adaptive, uint8_t minSeconds, uint8_t maxSeconds);
+    void resetHysteresis(LedaChannel &ch);
+    void restoreSnapshot(LedaChannel &ch);
+    void saveSnapshots();
+
+    void replayFrame(const char *line);
+    void runBenchmark(uint32_t iterations);
+    void setLogMode(const char *args);
+    void showMemory();
+    void showSessions(LedaChannel &ch);
+    void handleProfile(const char *args, bool diagnoseKo);
+    void handleCapture(const char *args);
+    void replayCapture();
+    void handleAnalyze(const char *args);
+    void showAnalysis();
+
 };
\ No newline at end of file
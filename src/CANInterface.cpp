@@ -1,47 +1,177 @@
-#include "CANInterface.h"
-#include "hardware.h" // Für PIN-Definitionen
-
-
-//--- CAN Quartz frequency
-const uint32_t QUARTZ_FREQUENCY = 16 * 1000 * 1000 ; // 16 MHz
-const uint32_t BIT_RATE = 125 * 1000 ; // 125 kbit/s
-
-// CAN Objekt
-ACAN2515 can(CAN0_CS_PIN, SPI, CAN0_INT_PIN);
-
-bool CANInterface::begin() {
-   //--- Set the SPI pins
-    SPI.setSCK(CAN0_SPI_SCK_PIN);    // SCK
-    SPI.setTX(CAN0_SPI_MOSI_PIN);    // MOSI
-    SPI.setRX(CAN0_SPI_MISO_PIN);    // MISO
-    SPI.setCS(CAN0_CS_PIN);          // Chip Select
-    SPI.begin();
-
-    // Configure the CAN controller settings
-    ACAN2515Settings settings(QUARTZ_FREQUENCY, BIT_RATE);
-    // Request Normal Mode for standard CAN communication
-    settings.mRequestedMode = ACAN2515Settings::NormalMode;
-
-    // Begin the CAN module initialization
-    // Passes the settings and a lambda function for the interrupt service routine (ISR)
-    const uint16_t errorCode = can.begin(settings, [] { can.isr(); });
-
-    // Check for initialization errors
-    if (0 == errorCode) {
-        // Initialization succeeded
-        Serial.println(F("CAN module initialized successfully"));
-    } else {
-        // Initialization failed
-        Serial.print(F("Error: CAN module initialization failed with error: 0x"));
-        Serial.println(errorCode, HEX); // Print the error code in hexadecimal
-    }
-    return (0 == errorCode);
-}
-
-bool CANInterface::available() {
-    return can.available();
-}
-
-void CANInterface::getNextMessage(CANMessage &msg) {
-    can.receive(msg);
+#include "CANInterface.h"
+#include "SpscRing.h"
+#include "CanBusTelemetry.h"
+#include "hardware.h" // Für PIN-Definitionen
+#if LEDA_IDLE_ENABLED
+    #include <hardware/sync.h>
+#endif
+
+
+//--- CAN Quartz frequency
+const uint32_t QUARTZ_FREQUENCY = 16 * 1000 * 1000 ; // 16 MHz
+const uint32_t BIT_RATE = 125 * 1000 ; // 125 kbit/s
+
+// CAN Objekt
+ACAN2515 can(CAN0_CS_PIN, SPI, CAN0_INT_PIN);
+
+// Empfangsring: Erzeuger ist die ISR, Verbraucher loop1
+static SpscRing<CANMessage, LEDA_CAN_RX_RING_SIZE> rxRing;
+
+// Sendestatistik (nur loop1)
+static uint32_t txFrameCount = 0;
+static uint32_t txBusyCount = 0;
+
+// Bits auf dem Bus: Empfang zählt die ISR, Senden loop1
+static volatile uint32_t rxBitCount = 0;
+static uint32_t txBitCount = 0;
+
+/**
+ * @brief Interrupt-Routine: liest den MCP2515 aus und legt alle Frames im Ring ab.
+ * Ist der Ring voll, wird der Frame verworfen und in rxOverflows() gezählt.
+ * Für die Buslast zählt er trotzdem. Das Ereignis weckt loop1 aus dem
+ * Leerlauf, auch wenn die ISR auf dem anderen Kern läuft.
+ */
+void CANInterface::isr() {
+    can.isr();
+    CANMessage msg;
+    while (can.receive(msg)) {
+        rxBitCount = rxBitCount + CanBusTelemetry::frameBits(msg);
+        rxRing.push(msg);
+    }
+#if LEDA_IDLE_ENABLED
+    __sev();
+#endif
+}
+
+// Der MCP2515 hat 6 Akzeptanzfilter (RXF0-1 an RXM0, RXF2-5 an RXM1)
+const uint8_t MCP2515_FILTER_COUNT = 6;
+const uint16_t STANDARD_ID_MASK = 0x7FF;
+
+/**
+ * @brief Startet den MCP2515 mit Masken/Filtern für die angegebenen IDs.
+ *
+ * Passen die IDs nicht in die 6 Filter, wird eine gemeinsame Maske über alle IDs
+ * gebildet. Diese lässt eine Obermenge durch, der Rest wird bei der Verteilung
+ * auf die Kanäle verworfen.
+ */
+static uint16_t beginFiltered(const ACAN2515Settings &settings, void (*isr)(), const uint16_t *accepted, uint8_t idCount) {
+    uint16_t ids[MCP2515_FILTER_COUNT];
+    uint16_t mask = STANDARD_ID_MASK;
+
+    if (idCount <= MCP2515_FILTER_COUNT) {
+        for (uint8_t i = 0; i < idCount; i++)
+            ids[i] = accepted[i];
+    } else {
+        // Alle Bits ausblenden, in denen sich die IDs unterscheiden
+        const uint16_t first = accepted[0];
+        for (uint8_t i = 1; i < idCount; i++)
+            mask &= ~(first ^ accepted[i]);
+        ids[0] = first & mask;
+    }
+    const uint8_t filterCount = (idCount <= MCP2515_FILTER_COUNT) ? idCount : 1;
+
+    // Freie Filter mit der letzten ID belegen
+    for (uint8_t i = filterCount; i < MCP2515_FILTER_COUNT; i++)
+        ids[i] = ids[filterCount - 1];
+
+    const ACAN2515Mask rxm = standard2515Mask(mask, 0, 0);
+    const ACAN2515AcceptanceFilter filters[MCP2515_FILTER_COUNT] = {
+        {standard2515Filter(ids[0], 0, 0), nullptr},
+        {standard2515Filter(ids[1], 0, 0), nullptr},
+        {standard2515Filter(ids[2], 0, 0), nullptr},
+        {standard2515Filter(ids[3], 0, 0), nullptr},
+        {standard2515Filter(ids[4], 0, 0), nullptr},
+        {standard2515Filter(ids[5], 0, 0), nullptr},
+    };
+    return can.begin(settings, isr, rxm, rxm, filters, MCP2515_FILTER_COUNT);
+}
+
+bool CANInterface::begin(bool promiscuous, const uint16_t *ids, uint8_t idCount) {
+   //--- Set the SPI pins
+    SPI.setSCK(CAN0_SPI_SCK_PIN);    // SCK
+    SPI.setTX(CAN0_SPI_MOSI_PIN);    // MOSI
+    SPI.setRX(CAN0_SPI_MISO_PIN);    // MISO
+    SPI.setCS(CAN0_CS_PIN);          // Chip Select
+    SPI.begin();
+
+    // Configure the CAN controller settings
+    ACAN2515Settings settings(QUARTZ_FREQUENCY, BIT_RATE);
+    // Request Normal Mode for standard CAN communication
+    settings.mRequestedMode = ACAN2515Settings::NormalMode;
+    // Treiberpuffer explizit setzen, die eigentliche Pufferung übernimmt rxRing
+    settings.mReceiveBufferSize = LEDA_CAN_DRIVER_RX_BUFFER;
+    settings.mTransmitBuffer0Size = LEDA_CAN_DRIVER_TX_BUFFER;
+
+    // Begin the CAN module initialization
+    // Passes the settings and the interrupt service routine (ISR)
+    const uint16_t errorCode = (promiscuous || idCount == 0) ? can.begin(settings, isr) : beginFiltered(settings, isr, ids, idCount);
+
+    // Check for initialization errors
+    if (0 == errorCode) {
+        // Initialization succeeded
+        Serial.println(F("CAN module initialized successfully"));
+    } else {
+        // Initialization failed
+        Serial.print(F("Error: CAN module initialization failed with error: 0x"));
+        Serial.println(errorCode, HEX); // Print the error code in hexadecimal
+    }
+    return (0 == errorCode);
+}
+
+bool CANInterface::available() {
+    return !rxRing.empty();
+}
+
+void CANInterface::getNextMessage(CANMessage &msg) {
+    rxRing.pop(msg);
+}
+
+bool CANInterface::tryTransmit(const CANMessage &msg) {
+    if (!can.tryToSend(msg)) {
+        txBusyCount++;
+        return false;
+    }
+    txFrameCount++;
+    txBitCount += CanBusTelemetry::frameBits(msg);
+    return true;
+}
+
+uint32_t CANInterface::txFrames() {
+    return txFrameCount;
+}
+
+uint32_t CANInterface::txBusy() {
+    return txBusyCount;
+}
+
+uint32_t CANInterface::busBits() {
+    return rxBitCount + txBitCount;
+}
+
+uint32_t CANInterface::bitRate() {
+    return BIT_RATE;
+}
+
+uint32_t CANInterface::rxOverflows() {
+    return rxRing.overflows();
+}
+
+uint16_t CANInterface::rxHighWater() {
+    return rxRing.highWater();
+}
+
+uint16_t CANInterface::rxCapacity() {
+    return rxRing.capacity();
+}
+
+uint16_t CANInterface::rxDriverPeak() {
+    return can.receiveBufferPeakCount();
+}
+
+CanErrorState CANInterface::readErrorState() {
+    CanErrorState state;
+    state.tec = can.transmitErrorCounter();
+    state.rec = can.receiveErrorCounter();
+    state.eflg = can.errorFlagRegister();
+    return state;
 }
\ No newline at end of file
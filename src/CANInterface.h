@@ -1,10 +1,92 @@
-#pragma once
-
-#include <ACAN2515.h>
-
-class CANInterface {
-public:
-    static bool begin();
-    static bool available();
-    static void getNextMessage(CANMessage &msg);
-};
\ No newline at end of file
+#pragma once
+
+#include <ACAN2515.h>
+
+// Größe des Empfangsrings zwischen ISR und loop1 (Zweierpotenz).
+// Anhand von rxHighWater() aus dem Feld dimensionieren.
+#ifndef LEDA_CAN_RX_RING_SIZE
+    #define LEDA_CAN_RX_RING_SIZE 64
+#endif
+
+// Puffer im ACAN2515-Treiber. Die ISR leert ihn sofort in den Ring,
+// daher genügen wenige Plätze.
+#ifndef LEDA_CAN_DRIVER_RX_BUFFER
+    #define LEDA_CAN_DRIVER_RX_BUFFER 4
+#endif
+
+// Sendepuffer im ACAN2515-Treiber. Befehle werden in CanTxQueue priorisiert,
+// der Treiber nimmt nur einzelne Frames auf.
+#ifndef LEDA_CAN_DRIVER_TX_BUFFER
+    #define LEDA_CAN_DRIVER_TX_BUFFER 2
+#endif
+
+// Leerlauf von loop1: Core 1 wartet per WFE auf den nächsten Frame oder Termin
+// der CAN-Seite (s. CANGateway::idle). Die Pause blockiert loop1 aller Module,
+// daher nur einschalten, wenn kein anderes Modul loop1 nutzt (Core 1 gehört
+// allein diesem Modul). Sonst übernimmt der OpenKNX-Core den Leerlauf.
+#ifndef LEDA_IDLE_ENABLED
+    #define LEDA_IDLE_ENABLED 0
+#endif
+#if LEDA_IDLE_ENABLED && !defined(OPENKNX_DUALCORE)
+    #error "LEDA_IDLE_ENABLED benötigt OPENKNX_DUALCORE (eigener Kern für die CAN-Seite)"
+#endif
+
+// Höchstdauer einer Pause, danach prüft loop1 die Termine der CAN-Seite erneut
+#ifndef LEDA_IDLE_MAX_MS
+    #define LEDA_IDLE_MAX_MS 20
+#endif
+
+/**
+ * @brief Fehlerzustand des MCP2515 (TEC/REC und EFLG-Register).
+ */
+struct CanErrorState {
+    uint8_t tec = 0;    // Transmit Error Counter
+    uint8_t rec = 0;    // Receive Error Counter
+    uint8_t eflg = 0;   // Error Flag Register
+
+    bool busOff() const { return eflg & 0x20; }             // TXBO
+    bool errorPassive() const { return eflg & 0x18; }       // TXEP | RXEP
+    bool errorWarning() const { return eflg & 0x01; }       // EWARN
+    bool rxOverflow() const { return eflg & 0xC0; }         // RX1OVR | RX0OVR
+};
+
+class CANInterface {
+public:
+    /**
+     * @brief Initialisiert SPI und MCP2515.
+     * Die ISR läuft auf dem aufrufenden Kern; tryTransmit() und readErrorState()
+     * nur von diesem Kern aufrufen (Dual-Core: setup1/loop1).
+     * @param promiscuous true: alle Frames empfangen (Diagnose), false: nur die übergebenen IDs
+     * @param ids         Anzunehmende IDs (dekodierte IDs aller Kanäle)
+     */
+    static bool begin(bool promiscuous, const uint16_t *ids, uint8_t idCount);
+    static bool available();
+    static void getNextMessage(CANMessage &msg);
+
+    /**
+     * @brief Übergibt einen Frame an den Treiber, ohne zu warten.
+     * Arbitrierungsverlust und fehlendes ACK wiederholt der MCP2515 selbstständig.
+     * @return false, wenn der Sendepuffer des Treibers voll ist
+     */
+    static bool tryTransmit(const CANMessage &msg);
+
+    // Diagnose des Empfangsrings
+    static uint32_t rxOverflows();
+    static uint16_t rxHighWater();
+    static uint16_t rxCapacity();
+    static uint16_t rxDriverPeak();
+
+    // Diagnose des Sendepfads
+    static uint32_t txFrames();
+    static uint32_t txBusy();
+
+    // Bits aller empfangenen und gesendeten Frames seit Start (Buslast, s. CanBusTelemetry)
+    static uint32_t busBits();
+    static uint32_t bitRate();
+
+    // Liest TEC, REC und EFLG per SPI (nicht im Empfangspfad aufrufen)
+    static CanErrorState readErrorState();
+
+private:
+    static void isr();
+};
@@ -0,0 +1,41 @@
+#include "CanBusTelemetry.h"
+
+void CanBusTelemetry::begin(uint32_t now, uint32_t busBits) {
+    _windowStart = now;
+    _windowBits = busBits;
+}
+
+bool CanBusTelemetry::sample(uint32_t now, const CanErrorState &errors, uint32_t busBits, uint32_t ringOverflows) {
+    if (errors.busOff())
+        _status.state = CanBusState::BusOff;
+    else if (errors.errorPassive())
+        _status.state = CanBusState::Passive;
+    else if (errors.errorWarning())
+        _status.state = CanBusState::Warning;
+    else
+        _status.state = CanBusState::Active;
+
+    // Der MCP2515 hält RXnOVR bis zum Löschen, gezählt wird der Wechsel auf gesetzt
+    if (errors.rxOverflow() && !_overflowFlag)
+        _hardwareOverflows++;
+    _overflowFlag = errors.rxOverflow();
+    const uint32_t overflows = ringOverflows + _hardwareOverflows;
+    _status.overflows = overflows > 0xFFFF ? 0xFFFF : overflows;
+
+    const uint32_t elapsed = now - _windowStart;
+    const bool windowDone = elapsed >= LEDA_CAN_BUSLOAD_WINDOW_MS;
+    if (windowDone) {
+        // Bits * 100 % / (Bitrate * Fensterlänge in s)
+        const uint64_t load = (uint64_t)(busBits - _windowBits) * 100000 / ((uint64_t)CANInterface::bitRate() * elapsed);
+        _status.loadPercent = load > 100 ? 100 : load;
+        _windowStart = now;
+        _windowBits = busBits;
+    }
+
+    // Ein neuer Fehlerzustand wird sofort gemeldet, Last und Überläufe je Fenster
+    const bool changed = _status.state != _reported.state ||
+                         (windowDone && (_status.loadPercent != _reported.loadPercent || _status.overflows != _reported.overflows));
+    if (changed)
+        _reported = _status;
+    return changed;
+}
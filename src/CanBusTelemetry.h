@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+#include "CANInterface.h"
+
+// Messfenster der Buslast
+#ifndef LEDA_CAN_BUSLOAD_WINDOW_MS
+    #define LEDA_CAN_BUSLOAD_WINDOW_MS 10000
+#endif
+
+// Mindeständerung der Buslast in Prozentpunkten, ab der erneut gesendet wird
+#ifndef LEDA_CAN_BUSLOAD_HYSTERESIS
+    #define LEDA_CAN_BUSLOAD_HYSTERESIS 2
+#endif
+
+/**
+ * @brief Fehlerzustand des CAN-Controllers (Wert des KOs, DPT 5.010).
+ */
+namespace CanBusState {
+    enum : uint8_t {
+        Active,         // Fehlerzähler unter 96
+        Warning,        // EWARN: TEC oder REC ab 96
+        Passive,        // TXEP/RXEP: TEC oder REC über 127
+        BusOff,         // TXBO: TEC über 255, der Controller sendet nicht mehr
+    };
+}
+
+/**
+ * @brief Zustand des Busses, wie er an die KNX-Seite geht.
+ */
+struct CanBusStatus {
+    uint8_t loadPercent = 0;
+    uint8_t state = CanBusState::Active;
+    uint16_t overflows = 0;         // Empfangsüberläufe seit Start (Ring und MCP2515), sättigt bei 0xFFFF
+};
+
+/**
+ * @brief Buslast und Fehlerzustand des CAN-Busses (CAN-Seite).
+ *
+ * Die Buslast wird aus den Bits der empfangenen und gesendeten Frames
+ * geschätzt (s. frameBits) und auf die Bitrate bezogen. Bei gefiltertem
+ * Empfang sieht der Treiber nur die angenommenen IDs, der Wert ist dann eine
+ * Untergrenze. Fehlerzustand und Überläufe kommen aus der Abfrage der
+ * Fehlerzähler, es gibt keinen zusätzlichen SPI-Zugriff.
+ */
+class CanBusTelemetry {
+public:
+    /**
+     * @brief Geschätzte Länge eines Frames auf dem Bus in Bit.
+     *
+     * Rahmen inkl. Interframe-Space (Standard 47, Extended 67 Bit plus Daten)
+     * zuzüglich der Hälfte der im ungünstigsten Fall nötigen Stuff-Bits.
+     */
+    static uint16_t frameBits(const CANMessage &msg) {
+        const uint16_t data = msg.rtr ? 0 : 8 * (msg.len > 8 ? 8 : msg.len);
+        const uint16_t stuffed = (msg.ext ? 54 : 34) + data;
+        return (msg.ext ? 67 : 47) + data + (stuffed - 1) / 8;
+    }
+
+    void begin(uint32_t now, uint32_t busBits);
+
+    /**
+     * @brief Wertet eine Abfrage der Fehlerzähler aus und schließt ggf. das Lastfenster.
+     * @param busBits       Bits aller Frames seit Start (CANInterface::busBits)
+     * @param ringOverflows Verworfene Frames im Empfangsring seit Start
+     * @return true, wenn sich status() geändert hat
+     */
+    bool sample(uint32_t now, const CanErrorState &errors, uint32_t busBits, uint32_t ringOverflows);
+
+    const CanBusStatus &status() const { return _status; }
+    uint32_t hardwareOverflows() const { return _hardwareOverflows; }
+
+private:
+    CanBusStatus _status;
+    CanBusStatus _reported;             // Zuletzt mit sample() == true gemeldeter Stand
+    uint32_t _windowStart = 0;
+    uint32_t _windowBits = 0;           // busBits zu Beginn des Fensters
+    uint32_t _hardwareOverflows = 0;    // Gesetzte RXnOVR-Flags (Flanken je Abfrage)
+    bool _overflowFlag = false;
+};
@@ -0,0 +1,200 @@
+#include "CanCapture.h"
+#include "SpscRing.h"
+#include <atomic>
+#if LEDA_CAPTURE_ENABLED
+    #include <LittleFS.h>
+#endif
+
+namespace CanCapture {
+
+    using namespace CanCaptureFormat;
+
+    void toMessage(const Record &record, CANMessage &msg) {
+        msg.id = record.id;
+        msg.ext = record.flags & FLAG_EXTENDED;
+        msg.rtr = record.flags & FLAG_REMOTE;
+        msg.len = (record.len > 8) ? 8 : record.len;
+        memcpy(msg.data, record.data, 8);
+    }
+
+#if LEDA_CAPTURE_ENABLED
+    static const char *const FILE_DIR = "/leda";
+    static const char *const FILE_PATH = "/leda/capture.bin";
+
+    // Frame mit absolutem Zeitstempel, Delta wird erst beim Schreiben gebildet
+    struct Sample {
+        uint32_t millis;
+        Record record;
+    };
+
+    // loop1 -> loop
+    static SpscRing<Sample, LEDA_CAPTURE_RING_SIZE> _ring;
+    static std::atomic<bool> _active{false};
+
+    static constexpr uint8_t PAGES_PER_BLOCK = LEDA_CAPTURE_BLOCK_SIZE / PAGE_SIZE;
+    static_assert(LEDA_CAPTURE_BLOCK_SIZE % PAGE_SIZE == 0, "LEDA_CAPTURE_BLOCK_SIZE muss ein Vielfaches der Seite sein");
+
+    // Nur loop
+    static File _file;
+    static Page _block[PAGES_PER_BLOCK];    // Seiten des laufenden Blocks, _block[_filled] wird befüllt
+    static uint8_t _filled = 0;             // Abgeschlossene Seiten im Block
+    static uint32_t _lastMillis = 0;
+    static uint32_t _sequence = 0;          // Sequenz der Seite _block[0]
+    static uint16_t _pageCount = 0;         // Seiten im Ring (Vielfaches von PAGES_PER_BLOCK)
+    static uint32_t _pagesWritten = 0;
+    static uint32_t _recorded = 0;
+    static uint32_t _overflowBase = 0;
+
+    bool active() {
+        return _active.load(std::memory_order_acquire);
+    }
+
+    void record(const CANMessage &msg, uint32_t now) {
+        if (!active()) return;
+        Sample sample;
+        sample.millis = now;
+        sample.record.deltaMs = 0;
+        sample.record.len = msg.len;
+        sample.record.flags = (msg.ext ? FLAG_EXTENDED : 0) | (msg.rtr ? FLAG_REMOTE : 0);
+        sample.record.id = msg.id;
+        memcpy(sample.record.data, msg.data, 8);
+        _ring.push(sample);
+    }
+
+    /**
+     * @brief Schreibt die abgeschlossenen Seiten des Blocks an ihren Platz im Ring.
+     * Der Block liegt blockweise ausgerichtet in der Datei, ein voller Block ist
+     * damit ein Write und ein Erase.
+     */
+    static void writeBlock() {
+        if (_filled == 0) return;
+        const uint32_t offset = (uint32_t)(_sequence % _pageCount) * PAGE_SIZE;
+        if (_file.position() != offset)
+            _file.seek(offset);
+        _file.write((const uint8_t *)_block, (size_t)_filled * PAGE_SIZE);
+        _file.flush();
+        _pagesWritten += _filled;
+    }
+
+    /**
+     * @brief Schließt die aktuelle Seite ab; ein voller Block wird geschrieben.
+     */
+    static void closePage() {
+        Page &page = _block[_filled];
+        page.header.magic = PAGE_MAGIC;
+        page.header.version = VERSION;
+        page.header.sequence = _sequence + _filled;
+        if (++_filled < PAGES_PER_BLOCK) return;
+
+        writeBlock();
+        _sequence += _filled;
+        _filled = 0;
+        memset(_block, 0, sizeof(_block));
+    }
+
+    static void append(const Sample &sample) {
+        Page *page = &_block[_filled];
+        uint32_t delta = sample.millis - _lastMillis;
+        // Abstand passt nicht in 16 Bit: neue Seite mit eigener Basiszeit
+        if (page->header.count > 0 && delta > 0xFFFF) {
+            closePage();
+            page = &_block[_filled];
+        }
+        if (page->header.count == 0) {
+            page->header.baseMillis = sample.millis;
+            delta = 0;
+        }
+
+        Record &record = page->records[page->header.count++];
+        record = sample.record;
+        record.deltaMs = (uint16_t)delta;
+        _lastMillis = sample.millis;
+        _recorded++;
+
+        if (page->header.count == RECORDS_PER_PAGE)
+            closePage();
+    }
+
+    void service() {
+        if (!_file) return;
+        Sample sample;
+        while (_ring.pop(sample))
+            append(sample);
+    }
+
+    bool start(uint16_t sizeKb) {
+        stop();
+        if (!LittleFS.begin()) return false;
+        LittleFS.mkdir(FILE_DIR);
+        _file = LittleFS.open(FILE_PATH, "w+");
+        if (!_file) return false;
+
+        // Reste einer früheren Aufzeichnung verwerfen
+        Sample sample;
+        while (_ring.pop(sample)) {}
+
+        // Ganze Blöcke, mindestens einer
+        _pageCount = (uint16_t)(((uint32_t)sizeKb * 1024) / LEDA_CAPTURE_BLOCK_SIZE * PAGES_PER_BLOCK);
+        if (_pageCount == 0) _pageCount = PAGES_PER_BLOCK;
+        memset(_block, 0, sizeof(_block));
+        _filled = 0;
+        _sequence = 0;
+        _pagesWritten = 0;
+        _recorded = 0;
+        _overflowBase = _ring.overflows();
+        _active.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void stop() {
+        if (!_file) return;
+        _active.store(false, std::memory_order_release);
+        service();
+        if (_block[_filled].header.count > 0)
+            closePage();
+        writeBlock();
+        _filled = 0;
+        _file.close();
+    }
+
+    int32_t replay(void (*f)(uint32_t millis, const CANMessage &msg, void *context), void *context) {
+        if (active() || !LittleFS.begin()) return -1;
+        File file = LittleFS.open(FILE_PATH, "r");
+        if (!file) return -1;
+
+        // Älteste Seite suchen (kleinste Sequenz)
+        const uint16_t pages = file.size() / PAGE_SIZE;
+        uint16_t first = 0;
+        uint32_t firstSequence = UINT32_MAX;
+        PageHeader header;
+        for (uint16_t i = 0; i < pages; i++) {
+            file.seek((uint32_t)i * PAGE_SIZE);
+            if (file.read((uint8_t *)&header, sizeof(header)) != sizeof(header)) break;
+            if (header.magic == PAGE_MAGIC && header.sequence < firstSequence) {
+                firstSequence = header.sequence;
+                first = i;
+            }
+        }
+
+        int32_t records = 0;
+        Page page;
+        CANMessage msg;
+        for (uint16_t i = 0; i < pages; i++) {
+            file.seek((uint32_t)((first + i) % pages) * PAGE_SIZE);
+            if (file.read((uint8_t *)&page, PAGE_SIZE) != PAGE_SIZE) break;
+            if (page.header.sequence != firstSequence + i) break;
+            forEachRecord(page, [&](uint32_t millis, const Record &record) {
+                toMessage(record, msg);
+                f(millis, msg, context);
+                records++;
+            });
+        }
+        file.close();
+        return records;
+    }
+
+    uint32_t recorded() { return _recorded; }
+    uint32_t dropped() { return _ring.overflows() - _overflowBase; }
+    uint32_t pagesWritten() { return _pagesWritten; }
+#endif
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <ACAN2515.h>
+#include "CanCaptureFormat.h"
+
+// Aufzeichnung einkompilieren (benötigt LittleFS)
+#ifndef LEDA_CAPTURE_ENABLED
+    #define LEDA_CAPTURE_ENABLED 1
+#endif
+
+// Puffer zwischen loop1 (Erfassung) und loop (Schreiben), Zweierpotenz.
+// Muss die Frames eines ganzen Blocks aufnehmen, solange dieser geschrieben wird.
+#ifndef LEDA_CAPTURE_RING_SIZE
+    #define LEDA_CAPTURE_RING_SIZE 32
+#endif
+
+// Geschrieben wird je Erase-Block des Flash (LittleFS-Blockgröße auf dem RP2040),
+// so viel RAM belegt der Seitenpuffer während einer Aufzeichnung
+#ifndef LEDA_CAPTURE_BLOCK_SIZE
+    #define LEDA_CAPTURE_BLOCK_SIZE 4096
+#endif
+
+/**
+ * @brief Aufzeichnung roher CAN-Frames in einen Ring auf LittleFS.
+ *
+ * record() läuft auf loop1 und legt den Frame nur in einen lock-freien Puffer.
+ * service() läuft auf loop, sammelt die Frames zu Seiten (CanCaptureFormat)
+ * und die Seiten zu einem Erase-Block; erst der volle Block wird am Stück
+ * geschrieben. Ist der Puffer voll, wird der Frame verworfen und gezählt.
+ *
+ * Grenze: loop1 wartet zwar nie auf das Dateisystem, wird aber während jedes
+ * Program/Erase des Flash angehalten. Der Arduino-Core legt den anderen Kern
+ * dafür still (idleOtherCore), da der Code aus dem Flash ausgeführt wird; auch
+ * die MCP2515-ISR auf Core 1 läuft dann nicht. Der MCP2515 puffert in der Zeit
+ * nur zwei Frames, weitere gehen verloren (RX0OVR/RX1OVR im EFLG, s.
+ * CanBusTelemetry). Ein Block je LEDA_CAPTURE_BLOCK_SIZE hält die Zahl dieser
+ * Pausen klein; bei den wenigen Frames je Sekunde des LEDA-Busses genügt das.
+ */
+namespace CanCapture {
+
+#if LEDA_CAPTURE_ENABLED
+    /**
+     * @brief Startet eine neue Aufzeichnung (bestehende Datei wird ersetzt).
+     * @param sizeKb Größe des Rings in KB
+     */
+    bool start(uint16_t sizeKb);
+
+    /**
+     * @brief Beendet die Aufzeichnung und schreibt den angefangenen Block.
+     */
+    void stop();
+
+    bool active();
+
+    // loop1: Frame übernehmen
+    void record(const CANMessage &msg, uint32_t now);
+
+    // loop: gepufferte Frames in Seiten sammeln, volle Blöcke schreiben
+    void service();
+
+    /**
+     * @brief Liest die Aufzeichnung in zeitlicher Reihenfolge.
+     * Ruft f(millis, msg) für jeden Datensatz auf.
+     * @return Anzahl Datensätze, -1 wenn keine Aufzeichnung vorhanden ist.
+     */
+    int32_t replay(void (*f)(uint32_t millis, const CANMessage &msg, void *context), void *context);
+
+    uint32_t recorded();
+    uint32_t dropped();
+    uint32_t pagesWritten();
+#else
+    inline bool active() { return false; }
+    inline void record(const CANMessage &, uint32_t) {}
+    inline void service() {}
+#endif
+
+    void toMessage(const CanCaptureFormat::Record &record, CANMessage &msg);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Binärformat der CAN-Aufzeichnung (Datei /leda/capture.bin).
+ *
+ * Die Datei besteht nur aus Seiten zu 256 Byte (eine Flash-Page). Jede Seite
+ * beginnt mit einem Kopf, danach folgen bis zu 15 Datensätze zu 16 Byte.
+ * Alle Werte sind Little-Endian, es gibt keine variablen Längen. Das Host-Tool
+ * (tools/LedaCaptureAnalyze.cpp) liest die Datei daher per mmap als Array von
+ * Page, sortiert die Seiten nach sequence und speist jeden Datensatz direkt in
+ * LEDAProtocol::parseFrame ein. Die Datei ist ein Ring: nach dem Umlauf werden die ältesten
+ * Seiten überschrieben.
+ *
+ * Dieser Header hat keine Abhängigkeiten zu Arduino und kann im Host-Tool
+ * unverändert eingebunden werden.
+ */
+namespace CanCaptureFormat {
+
+    static constexpr uint32_t PAGE_MAGIC = 0x4743434C; // "LCCG"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t PAGE_SIZE = 256;
+
+    // Flags je Datensatz
+    static constexpr uint8_t FLAG_EXTENDED = 0x01;     // 29-Bit-ID
+    static constexpr uint8_t FLAG_REMOTE   = 0x02;     // RTR-Frame
+
+    struct PageHeader {
+        uint32_t magic;         // PAGE_MAGIC, sonst ist die Seite ungültig/leer
+        uint32_t sequence;      // Fortlaufende Seitennummer seit Start der Aufzeichnung
+        uint32_t baseMillis;    // millis() beim ersten Datensatz der Seite
+        uint16_t version;       // VERSION
+        uint16_t count;         // Belegte Datensätze (1..RECORDS_PER_PAGE)
+    };
+
+    struct Record {
+        uint16_t deltaMs;       // Abstand zum vorigen Datensatz (der erste zu baseMillis)
+        uint8_t len;            // DLC
+        uint8_t flags;          // FLAG_*
+        uint32_t id;            // CAN-ID
+        uint8_t data[8];        // Nutzdaten, unbenutzte Bytes 0
+    };
+
+    static constexpr uint8_t RECORDS_PER_PAGE = (PAGE_SIZE - sizeof(PageHeader)) / sizeof(Record);
+
+    struct Page {
+        PageHeader header;
+        Record records[RECORDS_PER_PAGE];
+    };
+
+    static_assert(sizeof(PageHeader) == 16, "Seitenkopf muss 16 Byte groß sein");
+    static_assert(sizeof(Record) == 16, "Datensatz muss 16 Byte groß sein");
+    static_assert(sizeof(Page) == PAGE_SIZE, "Seite muss genau eine Flash-Page füllen");
+
+    inline bool valid(const Page &page) {
+        return page.header.magic == PAGE_MAGIC && page.header.version == VERSION &&
+               page.header.count > 0 && page.header.count <= RECORDS_PER_PAGE;
+    }
+
+    /**
+     * @brief Ruft f(millis, record) für jeden Datensatz einer gültigen Seite auf.
+     * @return false bei ungültiger Seite.
+     */
+    template<typename F>
+    bool forEachRecord(const Page &page, F &&f) {
+        if (!valid(page)) return false;
+        uint32_t time = page.header.baseMillis;
+        for (uint8_t i = 0; i < page.header.count; i++) {
+            time += page.records[i].deltaMs;
+            f(time, page.records[i]);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Zuordnung Standard-CAN-ID (11 Bit) -> Kanal in konstanter Zeit.
+ *
+ * Eine Tabelle über alle 2048 IDs, 4 Bit je ID (1 KB). Damit kostet die
+ * Verteilung eines Frames einen Speicherzugriff, unabhängig von der Anzahl
+ * Kanäle und IDs.
+ */
+class CanIdMap {
+public:
+    static constexpr uint8_t NONE = 0x0F;
+    static constexpr uint16_t ID_COUNT = 0x800;
+
+    CanIdMap() { clear(); }
+
+    void clear() {
+        for (uint16_t i = 0; i < ID_COUNT / 2; i++) _table[i] = 0xFF;
+    }
+
+    /**
+     * @brief Ordnet eine ID einem Kanal zu.
+     * @return false bei ungültiger ID oder wenn die ID bereits vergeben ist
+     */
+    bool assign(uint32_t id, uint8_t channel) {
+        if (id >= ID_COUNT || channel >= NONE || lookup(id) != NONE) return false;
+        const uint8_t shift = (id & 1) * 4;
+        _table[id >> 1] = (_table[id >> 1] & ~(0x0F << shift)) | (channel << shift);
+        return true;
+    }
+
+    /**
+     * @return Kanal oder NONE
+     */
+    uint8_t lookup(uint32_t id) const {
+        if (id >= ID_COUNT) return NONE;
+        return (_table[id >> 1] >> ((id & 1) * 4)) & 0x0F;
+    }
+
+private:
+    uint8_t _table[ID_COUNT / 2];
+};
@@ -0,0 +1,115 @@
+#include "CanTrace.h"
+#include <ctype.h>
+
+namespace CanTrace {
+
+    const TraceFrame SAMPLE[] = {
+        {0x281, 8, {0x14, 0x00, 0x64, 0x64, 0x01, 0x00, 0x00, 0x10}}, // Start, 20 °C
+        {0x283, 8, {0x01, 0x14, 0x00, 0x14, 0x00, 0x01, 0x00, 0x00}},
+        {0x281, 8, {0x96, 0x00, 0x64, 0x64, 0x02, 0x00, 0x00, 0x10}}, // Anheizen, 150 °C
+        {0x283, 8, {0x02, 0x10, 0x00, 0x2A, 0x01, 0x03, 0x00, 0x00}},
+        {0x281, 8, {0x2C, 0x01, 0x50, 0x46, 0x03, 0x00, 0x00, 0x10}}, // Anheizen, 300 °C
+        {0x283, 8, {0x01, 0x2C, 0x01, 0x14, 0x00, 0x02, 0x00, 0x00}},
+        {0x281, 8, {0x20, 0x03, 0x32, 0x32, 0x04, 0x00, 0x00, 0x10}}, // Heizbetrieb, 800 °C
+        {0x283, 8, {0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+        {0x281, 8, {0xBC, 0x02, 0x28, 0x28, 0x08, 0x00, 0x00, 0x10}}, // Nachlegen, 700 °C
+        {0x283, 8, {0x01, 0x20, 0x03, 0x14, 0x00, 0xFF, 0x00, 0x00}},
+        {0x281, 8, {0xC8, 0x00, 0x0A, 0x0A, 0x07, 0x00, 0x00, 0x10}}, // Grundglut, 200 °C
+        {0x283, 8, {0x02, 0x11, 0x00, 0x2B, 0x01, 0x03, 0x00, 0x00}},
+        {0x281, 8, {0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10}}, // Bereit, 80 °C
+        {0x283, 8, {0x01, 0x20, 0x03, 0x14, 0x00, 0xFE, 0x00, 0x00}},
+        {0x381, 8, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // Fremdgerät
+        {0x283, 8, {0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, // Unbekannter Subtyp
+    };
+    const uint8_t SAMPLE_COUNT = sizeof(SAMPLE) / sizeof(SAMPLE[0]);
+
+    static int hexNibble(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        c = tolower(c);
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    static const char *skipSpace(const char *p) {
+        while (*p == ' ' || *p == '\t') p++;
+        return p;
+    }
+
+    // Liest eine Hex-Zahl bis zum nächsten Nicht-Hex-Zeichen
+    static const char *readHex(const char *p, uint32_t &value, uint8_t &digits) {
+        value = 0;
+        digits = 0;
+        int n;
+        while ((n = hexNibble(*p)) >= 0) {
+            value = (value << 4) | n;
+            digits++;
+            p++;
+        }
+        return p;
+    }
+
+    static bool readBytes(const char *p, CANMessage &msg, bool spaced) {
+        msg.len = 0;
+        while (msg.len < 8) {
+            if (spaced) p = skipSpace(p);
+            int hi = hexNibble(p[0]);
+            if (hi < 0) break;
+            int lo = hexNibble(p[1]);
+            if (lo < 0) return false;
+            msg.data[msg.len++] = (uint8_t)((hi << 4) | lo);
+            p += 2;
+        }
+        return true;
+    }
+
+    bool parseCandumpLine(const char *line, CANMessage &msg) {
+        msg.data64 = 0;
+        msg.ext = false;
+        msg.rtr = false;
+
+        const char *p = skipSpace(line);
+        // Zeitstempel "(1700000000.123456)" überspringen
+        if (*p == '(') {
+            while (*p && *p != ')') p++;
+            if (*p) p++;
+        }
+
+        // Token für Token suchen, bis eine ID gefunden wurde
+        while (*(p = skipSpace(p))) {
+            uint32_t id;
+            uint8_t digits;
+            const char *end = readHex(p, id, digits);
+
+            // Kompaktformat: 281#DATA
+            if (digits > 0 && *end == '#') {
+                msg.id = id;
+                msg.ext = digits > 3;
+                return readBytes(end + 1, msg, false);
+            }
+
+            // Standardformat: 281   [8]  2C 01 ...
+            if (digits > 0 && (*end == ' ' || *end == '\t')) {
+                const char *q = skipSpace(end);
+                if (*q == '[') {
+                    msg.id = id;
+                    msg.ext = digits > 3;
+                    while (*q && *q != ']') q++;
+                    if (!*q) return false;
+                    return readBytes(q + 1, msg, true);
+                }
+            }
+
+            // Token überspringen (z.B. "can0")
+            while (*p && *p != ' ' && *p != '\t') p++;
+        }
+        return false;
+    }
+
+    void toMessage(const TraceFrame &frame, CANMessage &msg) {
+        msg.id = frame.id;
+        msg.ext = false;
+        msg.rtr = false;
+        msg.len = frame.len;
+        memcpy(msg.data, frame.data, 8);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <ACAN2515.h>
+
+/**
+ * @brief Hilfsfunktionen zum Einspielen aufgezeichneter CAN-Frames (candump-Format).
+ */
+namespace CanTrace {
+
+    /**
+     * @brief Kompakter Frame für fest eingebaute Traces.
+     */
+    struct TraceFrame {
+        uint16_t id;
+        uint8_t len;
+        uint8_t data[8];
+    };
+
+    /**
+     * @brief Referenz-Trace eines Heizvorgangs (0x281 und alle 0x283 Subtypen).
+     */
+    extern const TraceFrame SAMPLE[];
+    extern const uint8_t SAMPLE_COUNT;
+
+    /**
+     * @brief Liest eine candump-Zeile ein.
+     *
+     * Unterstützt "281#2C01323204000010" (candump -L / cansend) sowie
+     * "can0  281   [8]  2C 01 32 32 04 00 00 10" (candump Standardausgabe).
+     * Vorangestellte Zeitstempel und Interface-Namen werden ignoriert.
+     *
+     * @return true, wenn ein gültiger Frame gelesen wurde.
+     */
+    bool parseCandumpLine(const char *line, CANMessage &msg);
+
+    void toMessage(const TraceFrame &frame, CANMessage &msg);
+}
@@ -0,0 +1,80 @@
+#include "CanTxQueue.h"
+
+bool CanTxQueue::push(const CANMessage &msg, uint8_t channel, uint8_t command, uint8_t value, uint8_t priority) {
+    uint8_t free = NONE;
+    for (uint8_t i = 0; i < LEDA_CAN_TX_QUEUE_SIZE; i++) {
+        Entry &entry = _entries[i];
+        if (!entry.used) {
+            if (free == NONE) free = i;
+            continue;
+        }
+        if (entry.channel == channel && entry.command == command) {
+            // Neuer Sollwert ersetzt den alten, Versuche beginnen von vorn
+            if (entry.inFlight) _inFlight--;
+            entry = {msg, 0, channel, command, value, priority, 0, true, false};
+            return true;
+        }
+    }
+    if (free == NONE) {
+        _dropped++;
+        return false;
+    }
+    _entries[free] = {msg, 0, channel, command, value, priority, 0, true, false};
+    _used++;
+    return true;
+}
+
+uint8_t CanTxQueue::next(uint32_t now) {
+    uint8_t best = NONE;
+    for (uint8_t i = 0; i < LEDA_CAN_TX_QUEUE_SIZE; i++) {
+        Entry &entry = _entries[i];
+        if (!entry.used) continue;
+        if (entry.inFlight) {
+            if ((int32_t)(now - entry.deadline) < 0) continue;
+            // Keine Quittung: erneut senden oder aufgeben
+            entry.inFlight = false;
+            _inFlight--;
+            if (entry.attempts >= _maxAttempts) {
+                _failed++;
+                remove(i);
+                continue;
+            }
+            _retries++;
+        }
+        if (best == NONE || entry.priority < _entries[best].priority)
+            best = i;
+    }
+    return best;
+}
+
+uint32_t CanTxQueue::nextDeadline() const {
+    const Entry *first = nullptr;
+    for (const Entry &entry : _entries) {
+        if (!entry.inFlight) continue;
+        if (!first || (int32_t)(entry.deadline - first->deadline) < 0)
+            first = &entry;
+    }
+    return first ? first->deadline : 0;
+}
+
+void CanTxQueue::sent(uint8_t index, uint32_t now) {
+    Entry &entry = _entries[index];
+    entry.attempts++;
+    entry.deadline = now + _ackTimeout;
+    if (!entry.inFlight) _inFlight++;
+    entry.inFlight = true;
+}
+
+void CanTxQueue::acknowledge(uint8_t index) {
+    _acknowledged++;
+    remove(index);
+}
+
+void CanTxQueue::remove(uint8_t index) {
+    Entry &entry = _entries[index];
+    if (!entry.used) return;
+    if (entry.inFlight) _inFlight--;
+    entry.used = false;
+    entry.inFlight = false;
+    _used--;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stdint.h>
+#include <ACAN2515.h>
+
+// Plätze der Sendewarteschlange (Befehle je Kanal werden zusammengefasst)
+#ifndef LEDA_CAN_TX_QUEUE_SIZE
+    #define LEDA_CAN_TX_QUEUE_SIZE 8
+#endif
+
+/**
+ * @brief Begrenzte Sendewarteschlange für CAN-Befehle mit Priorität und Quittung.
+ *
+ * Noch ohne Befehle: Die Sende-Frames des LEDA-Controllers sind nicht bekannt.
+ * Befehle werden erst angebunden (LEDAProtocol, Eingangs-KOs), wenn ihre Frames
+ * und die Quittung am Controller nachgewiesen sind.
+ *
+ * Je Kanal und Befehl gibt es höchstens einen Eintrag; ein neuer Wunsch ersetzt
+ * den alten (der letzte Sollwert zählt). Ein gesendeter Eintrag bleibt bis zur
+ * Quittung stehen. Kommt sie nicht innerhalb von ackTimeout, wird er erneut
+ * gesendet, nach maxAttempts Versuchen verworfen. Wiederholungen bei verlorener
+ * Arbitrierung oder fehlendem CAN-ACK übernimmt der MCP2515 selbst.
+ *
+ * Läuft vollständig auf loop1, ohne Sperren.
+ */
+class CanTxQueue {
+public:
+    static constexpr uint8_t NONE = 0xFF;
+
+    struct Entry {
+        CANMessage msg;
+        uint32_t deadline;      // Quittung erwartet bis (nur inFlight)
+        uint8_t channel;
+        uint8_t command;        // Vom Aufrufer vergeben, je Kanal eindeutig
+        uint8_t value;
+        uint8_t priority;       // 0 = höchste
+        uint8_t attempts;
+        bool used;
+        bool inFlight;
+    };
+
+    void begin(uint32_t ackTimeoutMs, uint8_t maxAttempts) {
+        _ackTimeout = ackTimeoutMs;
+        _maxAttempts = maxAttempts;
+    }
+
+    /**
+     * @brief Merkt einen Befehl vor bzw. ersetzt den vorhandenen desselben Kanals.
+     * @return false, wenn die Warteschlange voll ist
+     */
+    bool push(const CANMessage &msg, uint8_t channel, uint8_t command, uint8_t value, uint8_t priority);
+
+    /**
+     * @brief Nächster zu sendender Eintrag: nicht unterwegs oder Quittung überfällig.
+     * Einträge nach maxAttempts Versuchen werden dabei verworfen (failed()).
+     * @return Index oder NONE
+     */
+    uint8_t next(uint32_t now);
+
+    /**
+     * @brief Meldet, dass der Eintrag an den Treiber übergeben wurde.
+     */
+    void sent(uint8_t index, uint32_t now);
+
+    /**
+     * @brief Quittiert und entfernt einen Eintrag.
+     */
+    void acknowledge(uint8_t index);
+
+    /**
+     * @brief Frühester Quittungs-Timeout der gesendeten Einträge (Leerlauf von loop1).
+     * Nur sinnvoll, wenn inFlight() > 0.
+     */
+    uint32_t nextDeadline() const;
+
+    const Entry &entry(uint8_t index) const { return _entries[index]; }
+    static constexpr uint8_t capacity() { return LEDA_CAN_TX_QUEUE_SIZE; }
+    uint8_t inFlight() const { return _inFlight; }
+    bool idle() const { return _used == 0; }
+    uint8_t queued() const { return _used; }
+
+    // Diagnose
+    uint32_t acknowledged() const { return _acknowledged; }
+    uint32_t retries() const { return _retries; }
+    uint32_t failed() const { return _failed; }
+    uint32_t dropped() const { return _dropped; }
+
+private:
+    Entry _entries[LEDA_CAN_TX_QUEUE_SIZE] = {};
+    uint32_t _ackTimeout = 500;
+    uint8_t _maxAttempts = 3;
+    uint8_t _used = 0;
+    uint8_t _inFlight = 0;
+    uint32_t _acknowledged = 0;
+    uint32_t _retries = 0;
+    uint32_t _failed = 0;
+    uint32_t _dropped = 0;
+
+    void remove(uint8_t index);
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Raster für zyklisches Senden (alle Zeiten in millis, überlaufsicher).
+ *
+ * Jedes Feld sendet zu festen Rasterpunkten phase + k * cycle. Die Phase
+ * verteilt die Felder aller Kanäle gleichmäßig über den Zyklus und verschiebt
+ * das ganze Raster um einen Geräteversatz, damit mehrere Geräte am Bus nicht
+ * gleichzeitig senden.
+ */
+namespace CycleGrid {
+
+    inline uint32_t cycleMs(uint8_t minutes) { return minutes * 60000UL; }
+
+    /**
+     * @brief Phase eines Feldes im Zyklus.
+     * @param position  Position des Feldes unter allen zyklisch gesendeten Einträgen
+     * @param positions Anzahl aller Positionen
+     */
+    inline uint32_t phase(uint32_t seed, uint32_t position, uint32_t positions, uint32_t cycle) {
+        return (seed + position * (cycle / positions)) % cycle;
+    }
+
+    /**
+     * @brief Erster Rasterpunkt ab earliest (phase < cycle).
+     * Der Abstand wird über earliest % cycle gebildet: earliest - phase liefe
+     * vor dem ersten Rasterpunkt über, und 2^32 ist kein Vielfaches des Zyklus.
+     * Beim Überlauf von millis() (49 Tage) verschiebt sich das Raster einmalig.
+     */
+    inline uint32_t next(uint32_t earliest, uint32_t phase, uint32_t cycle) {
+        const uint32_t offset = (earliest % cycle + cycle - phase) % cycle;
+        return offset ? earliest + (cycle - offset) : earliest;
+    }
+
+    /**
+     * @brief Frühester Folgetermin nach einem Senden.
+     * Ein halber Zyklus statt eines ganzen: Kommt der Loop einige ms nach dem
+     * Rasterpunkt zum Senden, bleibt der nächste Rasterpunkt der Folgetermin,
+     * statt einen Zyklus zu überspringen.
+     */
+    inline uint32_t afterSend(uint32_t now, uint8_t minutes) { return now + cycleMs(minutes) / 2; }
+}
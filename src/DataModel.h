@@ -1,113 +1,199 @@
-#pragma once
-
-#include <stdint.h>
-#include <Arduino.h> // Für millis()
-
-/**
- * @brief Intelligentes Datenfeld, das Wert, Status und Zeitstempel kapselt.
- */
-template<typename T>
-struct Field {
-    T value;
-    bool updated = false;
-    uint32_t lastSentMillis = 0;
-
-    /**
-     * @brief Aktualisiert den Wert und setzt das Dirty-Flag nur bei echter Änderung.
-     */
-    void set(T newValue) {
-        if (value != newValue) {
-            value = newValue;
-            updated = true;
-        }
-    }
-
-    /**
-     * @brief Prüft, ob seit dem letzten Senden mehr Zeit vergangen ist als im Intervall definiert.
-     * @param intervalMinutes Minuten aus dem KNX-Parameter (0 = deaktiviert)
-     */
-    bool cycleElapsed(uint32_t intervalMinutes) {
-        if (intervalMinutes == 0) return false;
-        return (millis() - lastSentMillis >= (intervalMinutes * 60000));
-    }
-
-    /**
-     * @brief Setzt den Zeitstempel auf 'jetzt' und löscht das Dirty-Flag.
-     * Muss nach jedem erfolgreichen KNX-Senden aufgerufen werden.
-     */
-    void markAsSent() {
-        lastSentMillis = millis();
-        updated = false;
-    }
-};
-
-/**
- * @brief Zentralstruktur für alle Ofendaten.
- */
-struct Data {
-    // Numerische Messwerte (Hysterese + Zyklus möglich)
-    Field<int16_t>  combustion_temp;
-    Field<int16_t>  max_combustion_temp;
-    Field<int16_t>  smoldering_temp;
-    Field<uint8_t>  air_flap_act;
-    Field<uint8_t>  air_flap_target;
-    Field<int8_t>   trend;
-    
-    // Status-Werte (Meist nur Zyklus)
-    Field<uint8_t>  oven_state_num;
-    char            oven_state_text[20]; // Text braucht Sonderbehandlung (kein Field-Template)
-    uint32_t        oven_state_text_lastSent = 0;
-
-    // Zähler und Versionen (Meist Event-basiert / updated-Flag)
-    Field<uint16_t> burn_cycles;
-    Field<uint16_t> heating_error_count;
-    Field<uint8_t>  controller_version;
-
-    // Binäre Zustände (DPT 1.x)
-    Field<bool>     oven_heated;
-    Field<bool>     heating_error;
-    Field<bool>     ember_bed;
-    Field<bool>     critical_temperature;
-    Field<bool>     can_bus_error;
-    Field<bool>     is_online;
-
-    // Noch unbekannte Werte (nur für Debugging, nicht an KNX)
-    Field<uint8_t>  byte281_5;
-    Field<uint8_t>  byte281_6;
-    Field<uint16_t> unknown_counter;
-    Field<uint8_t>  byte283_1_6;
-    Field<uint8_t>  byte283_3_1;
-    Field<uint8_t>  byte283_3_2;
-    Field<uint8_t>  byte283_3_3;
-    Field<uint8_t>  byte283_3_4;
-    Field<uint8_t>  byte283_3_5;
-    Field<uint8_t>  byte283_3_6;
-
-    // Zeitstempel für den Online-Check
-    uint32_t        lastUpdateTimestamp = 0;
-};
-
-/**
- * @brief Standard-Initialisierungswerte
- */
-const Data DEFAULT_VALUES = {
-    .combustion_temp        = {-1000, false, 0},
-    .max_combustion_temp    = {-1000, false, 0},
-    .smoldering_temp        = {-1000, false, 0},
-    .air_flap_act           = {255,   false, 0},
-    .air_flap_target        = {255,   false, 0},
-    .trend                  = {127,   false, 0},
-    .oven_state_num         = {255,   false, 0},
-    .oven_state_text        = "Initialisierung",
-    .oven_state_text_lastSent = 0,
-    .burn_cycles            = {0,     false, 0},
-    .heating_error_count    = {0,     false, 0},
-    .controller_version     = {0,     false, 0},
-    .oven_heated            = {false, false, 0},
-    .heating_error          = {false, false, 0},
-    .ember_bed              = {false, false, 0},
-    .critical_temperature   = {false, false, 0},
-    .can_bus_error          = {false, false, 0},
-    .is_online              = {false, false, 0},
-    .lastUpdateTimestamp    = 0
-};
\ No newline at end of file
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Datenfeld. Änderungen werden in Data::dirty markiert,
+ * Sendezeitpunkte und zuletzt gesendete Werte verwaltet der KNX-Sync.
+ */
+template<typename T>
+struct Field {
+    T value;
+
+    /**
+     * @brief Aktualisiert den Wert.
+     * @return true bei echter Änderung. Das Dirty-Bit setzt Data::set().
+     */
+    bool set(T newValue) {
+        if (value == newValue) return false;
+        value = newValue;
+        return true;
+    }
+};
+
+/**
+ * @brief Bit-Index je Feld in Data::dirty.
+ */
+namespace DataField {
+    enum : uint8_t {
+        CombustionTemp,
+        MaxCombustionTemp,
+        SmolderingTemp,
+        AirFlapAct,
+        AirFlapTarget,
+        Trend,
+        OvenStateNum,
+        OvenStateText,
+        BurnCycles,
+        HeatingErrorCount,
+        ControllerVersion,
+        OvenHeated,
+        HeatingError,
+        EmberBed,
+        CriticalTemperature,
+        CanBusError,
+        IsOnline,
+        ConnectionLost,
+        Byte281_5,
+        Byte281_6,
+        UnknownCounter,
+        Byte283_1_6,
+        Byte283_3_1,
+        Byte283_3_2,
+        Byte283_3_3,
+        Byte283_3_4,
+        Byte283_3_5,
+        Byte283_3_6,
+        Count
+    };
+
+    constexpr uint32_t bit(uint8_t index) { return 1UL << index; }
+}
+static_assert(DataField::Count <= 32, "Dirty-Maske ist 32 Bit breit");
+
+// Zuordnung Data-Member -> DataField-Index, siehe Liste unter Data
+template<auto Member>
+inline constexpr uint8_t fieldIndex = 0xFF;
+
+/**
+ * @brief Zentralstruktur für alle Ofendaten.
+ *
+ * Nur die Werte selbst, nach Größe sortiert (kein Padding). Geänderte Felder
+ * stehen gemeinsam in dirty; Sendezeitpunkte und zuletzt gesendete Werte
+ * hält der KNX-Sync nur für die Felder, die sie brauchen.
+ */
+struct Data {
+    // --- 32 Bit ---
+    const char     *oven_state_text;     // Interner Text aus OvenStateText (kein Field-Template, nullptr = noch kein Status)
+
+    // Ein Bit je geändertem Feld (DataField), wird vom KNX-Sync abgearbeitet
+    uint32_t        dirty = 0;
+    // Ein Bit je Feld, das seit dem Start vom Ofen kam (bzw. lokal bestimmt wird); nur diese werden gesendet
+    uint32_t        valid = 0;
+
+    // --- 16 Bit ---
+    // Numerische Messwerte (Hysterese + Zyklus möglich)
+    Field<int16_t>  combustion_temp;
+    Field<int16_t>  max_combustion_temp;
+    Field<int16_t>  smoldering_temp;
+
+    // Zähler (Meist Event-basiert)
+    Field<uint16_t> burn_cycles;
+    Field<uint16_t> heating_error_count;
+    Field<uint16_t> unknown_counter;     // Noch unbekannt (nur für Debugging, nicht an KNX)
+
+    // --- 8 Bit ---
+    Field<uint8_t>  air_flap_act;
+    Field<uint8_t>  air_flap_target;
+    Field<int8_t>   trend;
+    Field<uint8_t>  oven_state_num;      // Status-Wert (Meist nur Zyklus)
+    Field<uint8_t>  controller_version;
+
+    // Noch unbekannte Werte (nur für Debugging, nicht an KNX)
+    Field<uint8_t>  byte281_5;
+    Field<uint8_t>  byte281_6;
+    Field<uint8_t>  byte283_1_6;
+    Field<uint8_t>  byte283_3_1;
+    Field<uint8_t>  byte283_3_2;
+    Field<uint8_t>  byte283_3_3;
+    Field<uint8_t>  byte283_3_4;
+    Field<uint8_t>  byte283_3_5;
+    Field<uint8_t>  byte283_3_6;
+
+    // Binäre Zustände (DPT 1.x)
+    Field<bool>     oven_heated;
+    Field<bool>     heating_error;
+    Field<bool>     ember_bed;
+    Field<bool>     critical_temperature;
+    Field<bool>     can_bus_error;
+    Field<bool>     is_online;
+    Field<bool>     connection_lost;
+
+    /**
+     * @brief Setzt einen Wert und markiert das Feld bei Änderung in der Dirty-Maske.
+     * Aufruf: data.set<&Data::combustion_temp>(wert)
+     */
+    template<auto Member, typename V>
+    void set(V newValue);
+
+    void markDirty(uint8_t index) { dirty |= DataField::bit(index); }
+};
+
+// RAM-Budget: 45 Byte Nutzdaten, auf ARM 48 Byte mit Ausrichtung. Im Host-Build
+// (64-Bit-Zeiger) wachsen oven_state_text und die Ausrichtung um je 4 Byte.
+static_assert(sizeof(Field<int16_t>) == 2 && sizeof(Field<uint8_t>) == 1, "Field darf nur den Wert enthalten");
+static_assert(sizeof(Data) <= 48 + 2 * (sizeof(void *) - 4), "Data überschreitet das RAM-Budget");
+
+#define LEDA_FIELD_INDEX(member, index) \
+    template<> inline constexpr uint8_t fieldIndex<&Data::member> = DataField::index;
+
+LEDA_FIELD_INDEX(combustion_temp,      CombustionTemp)
+LEDA_FIELD_INDEX(max_combustion_temp,  MaxCombustionTemp)
+LEDA_FIELD_INDEX(smoldering_temp,      SmolderingTemp)
+LEDA_FIELD_INDEX(air_flap_act,         AirFlapAct)
+LEDA_FIELD_INDEX(air_flap_target,      AirFlapTarget)
+LEDA_FIELD_INDEX(trend,                Trend)
+LEDA_FIELD_INDEX(oven_state_num,       OvenStateNum)
+LEDA_FIELD_INDEX(burn_cycles,          BurnCycles)
+LEDA_FIELD_INDEX(heating_error_count,  HeatingErrorCount)
+LEDA_FIELD_INDEX(controller_version,   ControllerVersion)
+LEDA_FIELD_INDEX(oven_heated,          OvenHeated)
+LEDA_FIELD_INDEX(heating_error,        HeatingError)
+LEDA_FIELD_INDEX(ember_bed,            EmberBed)
+LEDA_FIELD_INDEX(critical_temperature, CriticalTemperature)
+LEDA_FIELD_INDEX(can_bus_error,        CanBusError)
+LEDA_FIELD_INDEX(is_online,            IsOnline)
+LEDA_FIELD_INDEX(connection_lost,      ConnectionLost)
+LEDA_FIELD_INDEX(byte281_5,            Byte281_5)
+LEDA_FIELD_INDEX(byte281_6,            Byte281_6)
+LEDA_FIELD_INDEX(unknown_counter,      UnknownCounter)
+LEDA_FIELD_INDEX(byte283_1_6,          Byte283_1_6)
+LEDA_FIELD_INDEX(byte283_3_1,          Byte283_3_1)
+LEDA_FIELD_INDEX(byte283_3_2,          Byte283_3_2)
+LEDA_FIELD_INDEX(byte283_3_3,          Byte283_3_3)
+LEDA_FIELD_INDEX(byte283_3_4,          Byte283_3_4)
+LEDA_FIELD_INDEX(byte283_3_5,          Byte283_3_5)
+LEDA_FIELD_INDEX(byte283_3_6,          Byte283_3_6)
+
+#undef LEDA_FIELD_INDEX
+
+template<auto Member, typename V>
+inline void Data::set(V newValue) {
+    static_assert(fieldIndex<Member> < DataField::Count, "Feld fehlt in der DataField-Zuordnung");
+    if ((this->*Member).set(newValue))
+        dirty |= DataField::bit(fieldIndex<Member>);
+}
+
+/**
+ * @brief Standard-Initialisierungswerte
+ */
+const Data DEFAULT_VALUES = {
+    .oven_state_text        = nullptr,
+    .combustion_temp        = {-1000},
+    .max_combustion_temp    = {-1000},
+    .smoldering_temp        = {-1000},
+    .burn_cycles            = {0},
+    .heating_error_count    = {0},
+    .air_flap_act           = {255},
+    .air_flap_target        = {255},
+    .trend                  = {127},
+    .oven_state_num         = {255},
+    .controller_version     = {0},
+    .oven_heated            = {false},
+    .heating_error          = {false},
+    .ember_bed              = {false},
+    .critical_temperature   = {false},
+    .can_bus_error          = {false},
+    .is_online              = {false},
+    .connection_lost        = {false},
+};
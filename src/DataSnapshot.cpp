@@ -0,0 +1,74 @@
+#include "DataSnapshot.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <LittleFS.h>
+
+static const char *const SNAPSHOT_DIR = "/leda";
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x5357434C; // "LCWS"
+static constexpr uint16_t SNAPSHOT_VERSION = 2;
+
+// Wertebereich in Data: vom ersten bis zum letzten Field, zusammenhängend und ohne Zeiger
+static constexpr size_t VALUES_OFFSET = offsetof(Data, combustion_temp);
+static constexpr size_t VALUES_SIZE = offsetof(Data, connection_lost) + sizeof(Data::connection_lost) - VALUES_OFFSET;
+
+// Dateiformat: Kopf, Feldwerte, zuletzt gesendete Hysterese-Werte, laufende Sitzung
+struct SnapshotHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t valuesSize;
+    uint32_t known;
+};
+
+static void snapshotPath(uint8_t channel, char (&path)[24]) {
+    if (channel == 0)
+        snprintf(path, sizeof(path), "%s/snapshot.bin", SNAPSHOT_DIR);
+    else
+        snprintf(path, sizeof(path), "%s/snapshot%u.bin", SNAPSHOT_DIR, (unsigned)channel + 1);
+}
+
+bool DataSnapshot::load(uint8_t channel, Data &data, uint32_t &known, int16_t (&lastSent)[HysteresisSlot::Count],
+                        ActiveSession &session) {
+    char path[24];
+    snapshotPath(channel, path);
+    if (!LittleFS.begin()) return false;
+    File file = LittleFS.open(path, "r");
+    if (!file) return false;
+
+    SnapshotHeader header;
+    uint8_t values[VALUES_SIZE];
+    int16_t sent[HysteresisSlot::Count];
+    ActiveSession active;
+    bool ok = file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == SNAPSHOT_MAGIC && header.version == SNAPSHOT_VERSION &&
+              header.valuesSize == VALUES_SIZE &&
+              file.read(values, sizeof(values)) == sizeof(values) &&
+              file.read((uint8_t *)sent, sizeof(sent)) == sizeof(sent) &&
+              file.read((uint8_t *)&active, sizeof(active)) == sizeof(active);
+    file.close();
+    if (!ok) return false;
+
+    memcpy((uint8_t *)&data + VALUES_OFFSET, values, VALUES_SIZE);
+    memcpy(lastSent, sent, sizeof(sent));
+    session = active;
+    known = header.known;
+    return true;
+}
+
+bool DataSnapshot::save(uint8_t channel, const Data &data, uint32_t known, const HysteresisState &hysteresis,
+                        const ActiveSession &session) {
+    char path[24];
+    snapshotPath(channel, path);
+    if (!LittleFS.begin()) return false;
+    LittleFS.mkdir(SNAPSHOT_DIR);
+    File file = LittleFS.open(path, "w");
+    if (!file) return false;
+
+    const SnapshotHeader header = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION, (uint16_t)VALUES_SIZE, known};
+    bool ok = file.write((const uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+              file.write((const uint8_t *)&data + VALUES_OFFSET, VALUES_SIZE) == VALUES_SIZE &&
+              file.write((const uint8_t *)hysteresis.lastSent, sizeof(hysteresis.lastSent)) == sizeof(hysteresis.lastSent) &&
+              file.write((const uint8_t *)&session, sizeof(session)) == sizeof(session);
+    file.close();
+    return ok;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include "DataModel.h"
+#include "SendPolicy.h"
+#include "BurnSession.h"
+
+/**
+ * @brief Warmstart: letzter bekannter Stand eines Kanals im Dateisystem.
+ *
+ * Gespeichert werden die Feldwerte aus Data (ohne Text-Zeiger und Masken),
+ * die Maske der Felder mit bekanntem Wert, die zuletzt gesendeten
+ * Hysterese-Werte und die laufende Abbrand-Sitzung. Kopf mit Version und Größe des Wertebereichs: nach einer
+ * Änderung von Data wird eine alte Datei verworfen statt falsch gelesen.
+ *
+ * Läuft auf loop (setup bzw. KNX-Seite), eine Datei je Kanal.
+ */
+namespace DataSnapshot {
+
+    /**
+     * @brief Liest den Stand eines Kanals.
+     * @param data     Ziel der Feldwerte (übrige Member bleiben unverändert)
+     * @param known    Felder, deren Wert beim Speichern bekannt war
+     * @param lastSent Zuletzt gesendete Werte je Hysterese-Slot
+     * @param session  Laufende Sitzung beim Speichern (number == 0: keine)
+     * @return false, wenn keine passende Datei vorhanden ist
+     */
+    bool load(uint8_t channel, Data &data, uint32_t &known, int16_t (&lastSent)[HysteresisSlot::Count],
+              ActiveSession &session);
+
+    /**
+     * @brief Schreibt den Stand eines Kanals (ersetzt die Datei).
+     */
+    bool save(uint8_t channel, const Data &data, uint32_t known, const HysteresisState &hysteresis,
+              const ActiveSession &session);
+}
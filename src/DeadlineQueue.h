@@ -0,0 +1,128 @@
+#pragma once
+
+#include <stdint.h>
+#include <type_traits>
+
+/**
+ * @brief Indizierter Min-Heap für Fälligkeitszeitpunkte (millis()).
+ *
+ * Jeder Index (z.B. DataField) hat höchstens einen Eintrag. schedule()
+ * ersetzt einen vorhandenen Termin, due() prüft nur die Wurzel. Vergleiche
+ * sind überlaufsicher, solange alle Termine weniger als den halben
+ * Wertebereich von T auseinander liegen (uint32_t in ms: 24 Tage).
+ *
+ * @tparam N Anzahl möglicher Indizes
+ * @tparam T Zeittyp; kleinere Typen sparen RAM bei gröberer Zeitbasis
+ */
+template<uint8_t N, typename T = uint32_t>
+class DeadlineQueue {
+    static_assert(std::is_unsigned<T>::value, "Zeittyp muss vorzeichenlos sein");
+public:
+    static constexpr uint8_t NONE = 0xFF;
+
+    DeadlineQueue() {
+        for (uint8_t i = 0; i < N; i++) _pos[i] = NONE;
+    }
+
+    /**
+     * @brief Setzt (oder verschiebt) den Termin für index.
+     */
+    void schedule(uint8_t index, T deadline) {
+        uint8_t pos = _pos[index];
+        if (pos == NONE) {
+            pos = _size++;
+            _heap[pos] = index;
+            _pos[index] = pos;
+            _deadline[index] = deadline;
+            siftUp(pos);
+            return;
+        }
+        T old = _deadline[index];
+        _deadline[index] = deadline;
+        if (before(deadline, old)) siftUp(pos);
+        else siftDown(pos);
+    }
+
+    /**
+     * @brief Entfernt den Termin für index (falls vorhanden).
+     */
+    void cancel(uint8_t index) {
+        uint8_t pos = _pos[index];
+        if (pos == NONE) return;
+        _pos[index] = NONE;
+        if (--_size == pos) return;
+        // Letztes Element an die freie Stelle setzen und einsortieren
+        uint8_t moved = _heap[_size];
+        _heap[pos] = moved;
+        _pos[moved] = pos;
+        siftUp(pos);
+        siftDown(_pos[moved]);
+    }
+
+    bool scheduled(uint8_t index) const { return _pos[index] != NONE; }
+    T deadline(uint8_t index) const { return _deadline[index]; }
+    bool empty() const { return _size == 0; }
+
+    /**
+     * @brief Nächster Termin (nur gültig, wenn !empty()).
+     */
+    T next() const { return _deadline[_heap[0]]; }
+
+    /**
+     * @brief Ist der nächste Termin erreicht?
+     */
+    bool due(T now) const {
+        return _size > 0 && !before(now, next());
+    }
+
+    /**
+     * @brief Entfernt den nächsten Termin und liefert dessen Index.
+     */
+    uint8_t pop() {
+        uint8_t index = _heap[0];
+        cancel(index);
+        return index;
+    }
+
+private:
+    uint8_t _heap[N];
+    uint8_t _pos[N];
+    T _deadline[N] = {};
+    uint8_t _size = 0;
+
+    static bool before(T a, T b) { return (std::make_signed_t<T>)(T)(a - b) < 0; }
+
+    bool less(uint8_t posA, uint8_t posB) const {
+        return before(_deadline[_heap[posA]], _deadline[_heap[posB]]);
+    }
+
+    void swap(uint8_t posA, uint8_t posB) {
+        uint8_t a = _heap[posA];
+        _heap[posA] = _heap[posB];
+        _heap[posB] = a;
+        _pos[_heap[posA]] = posA;
+        _pos[_heap[posB]] = posB;
+    }
+
+    void siftUp(uint8_t pos) {
+        while (pos > 0) {
+            uint8_t parent = (pos - 1) / 2;
+            if (!less(pos, parent)) break;
+            swap(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void siftDown(uint8_t pos) {
+        while (true) {
+            uint8_t smallest = pos;
+            uint8_t left = 2 * pos + 1;
+            uint8_t right = left + 1;
+            if (left < _size && less(left, smallest)) smallest = left;
+            if (right < _size && less(right, smallest)) smallest = right;
+            if (smallest == pos) break;
+            swap(pos, smallest);
+            pos = smallest;
+        }
+    }
+};
@@ -0,0 +1,86 @@
+#include "KnxSendScheduler.h"
+
+void KnxSendScheduler::begin(uint8_t rate, uint8_t burst) {
+    _rate = rate > 0 ? rate : 1;
+    _capacity = (uint32_t)(burst > 0 ? burst : 1) * 1000;
+    _tokens = _capacity;
+}
+
+void KnxSendScheduler::hold(uint32_t until) {
+    _holdUntil = until;
+    _holding = true;
+}
+
+void KnxSendScheduler::request(uint8_t entry, SendPriority priority) {
+    const uint8_t word = entry >> 6;
+    const uint64_t bit = 1ULL << (entry & 63);
+    // Ein bereits vorgemerkter Eintrag wird nicht doppelt gesendet, höchstens
+    // in die dringendere Klasse verschoben
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        if (_pending[p][word] & bit) {
+            _coalesced++;
+            if (p > (uint8_t)priority) {
+                _pending[p][word] &= ~bit;
+                _pending[(uint8_t)priority][word] |= bit;
+            }
+            return;
+        }
+    }
+    _pending[(uint8_t)priority][word] |= bit;
+}
+
+void KnxSendScheduler::refill(uint32_t now) {
+    uint32_t elapsed = now - _lastRefill;
+    if (elapsed == 0) return;
+    _lastRefill = now;
+    // Nach langer Pause (next() läuft im Leerlauf nicht) vor dem Multiplizieren
+    // begrenzen, sonst läuft elapsed * _rate über
+    if (elapsed >= _capacity / _rate) {
+        _tokens = _capacity;
+        return;
+    }
+    uint32_t add = elapsed * _rate;   // ms * Telegramme/s = 1/1000 Telegramm
+    _tokens = (add >= _capacity - _tokens) ? _capacity : _tokens + add;
+}
+
+uint8_t KnxSendScheduler::next(uint32_t now) {
+    if (idle()) return NONE;
+
+    if (_holding) {
+        if ((int32_t)(now - _holdUntil) < 0) return NONE;
+        _holding = false;
+        _tokens = 0;
+        _lastRefill = now;
+    }
+
+    refill(now);
+    if (_tokens < 1000) return NONE;
+
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++) {
+        for (uint8_t w = 0; w < WORDS; w++) {
+            if (_pending[p][w] == 0) continue;
+            uint8_t bit = __builtin_ctzll(_pending[p][w]);
+            _pending[p][w] &= ~(1ULL << bit);
+            _tokens -= 1000;
+            _sent++;
+            return (w << 6) | bit;
+        }
+    }
+    return NONE;
+}
+
+bool KnxSendScheduler::idle() const {
+    uint64_t any = 0;
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++)
+        for (uint8_t w = 0; w < WORDS; w++)
+            any |= _pending[p][w];
+    return any == 0;
+}
+
+uint8_t KnxSendScheduler::queued() const {
+    uint8_t count = 0;
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++)
+        for (uint8_t w = 0; w < WORDS; w++)
+            count += __builtin_popcountll(_pending[p][w]);
+    return count;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Prioritätsklassen für ausgehende Telegramme.
+ */
+enum class SendPriority : uint8_t {
+    Alarm = 0,      // z.B. kritische Temperatur, Heizfehler
+    Status = 1,     // Messwerte und Zustände
+    Statistic = 2,  // Zähler, Version
+};
+
+/**
+ * @brief Begrenzt die Telegrammrate auf dem KNX-Bus und sortiert nach Priorität.
+ *
+ * Sendewünsche werden als Bit je Eintrag der Sende-Tabelle vorgemerkt. Ein
+ * erneuter Wunsch für denselben Eintrag ersetzt den alten (der Wert wird erst
+ * beim tatsächlichen Senden gelesen). Die Rate wird über einen Token-Bucket
+ * begrenzt: rate Telegramme/s, maximal burst am Stück.
+ */
+class KnxSendScheduler {
+public:
+    static constexpr uint8_t NONE = 0xFF;
+    static constexpr uint8_t PRIORITY_COUNT = 3;
+    static constexpr uint8_t WORDS = 2;            // 64-Bit-Worte je Priorität
+    static constexpr uint8_t CAPACITY = WORDS * 64; // Einträge (Bits je Priorität)
+
+    void begin(uint8_t rate, uint8_t burst);
+
+    /**
+     * @brief Hält alle Sendungen bis until zurück (Anlauf nach dem Start).
+     * Danach beginnt der Token-Bucket leer, vorgemerkte KOs gehen mit der
+     * konfigurierten Rate statt als Burst auf den Bus.
+     */
+    void hold(uint32_t until);
+
+    /**
+     * @brief Merkt einen Eintrag zum Senden vor.
+     * Ist er bereits mit niedrigerer Priorität vorgemerkt, wird er hochgestuft.
+     */
+    void request(uint8_t entry, SendPriority priority);
+
+    /**
+     * @brief Liefert den nächsten zu sendenden Eintrag, falls das Budget reicht.
+     * @return Eintrag oder NONE
+     */
+    uint8_t next(uint32_t now);
+
+    bool idle() const;
+    uint8_t queued() const;
+
+    // Diagnose
+    uint32_t sent() const { return _sent; }
+    uint32_t coalesced() const { return _coalesced; }
+
+private:
+    uint64_t _pending[PRIORITY_COUNT][WORDS] = {};
+    uint32_t _tokens = 0;           // in 1/1000 Telegramm
+    uint32_t _capacity = 0;
+    uint32_t _rate = 0;             // Telegramme pro Sekunde
+    uint32_t _lastRefill = 0;
+    uint32_t _holdUntil = 0;
+    bool _holding = false;
+    uint32_t _sent = 0;
+    uint32_t _coalesced = 0;
+
+    void refill(uint32_t now);
+};
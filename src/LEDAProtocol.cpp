@@ -1,234 +1,345 @@
-#include "LEDAProtocol.h"
-#include <Arduino.h>
-
-// Schwellenwerte für die Logik (wie im alten can_handler)
-const int16_t CRITICAL_TEMPERATURE_THRESHOLD = 750;
-const int16_t CRITICAL_TEMPERATURE_HYSTERESIS = 10;
-
-/**
- * @brief Decodes two bytes from a buffer into a 16-bit unsigned integer (Little-Endian).
- */
-static uint16_t decodeUInt16(const uint8_t* buffer, size_t size) {
-    if (size < 2) {
-        Serial.println(F("ERROR: Insufficient buffer size for 16-bit unsigned decode."));
-        return 0;
-    }
-    // Little-Endian: buffer[0] ist LSB, buffer[1] ist MSB
-    return (uint16_t)((buffer[1] << 8) | buffer[0]);
-}
-
-/**
- * @brief Processes and decodes a received CAN message based on its ID.
- *
- * @param msg The CAN message object.
- * @param data Reference to the Data structure to update.
- * @return true if the message ID and type were recognized and processed, false otherwise.
- */
-void LEDAProtocol::parseFrame(const CANMessage &msg, Data &data) {
-    int len;
-    char printBuffer[256];
-    switch (msg.id) {
-        case 0x281: {
-            // Byte 0 & 1: Combustion Temperature (16-bit, LSB first in °C)
-            data.combustion_temp.set((int16_t)decodeUInt16(msg.data + 0, 2));
-            
-            // Byte 2: Air Flap Actual Position
-            data.air_flap_act.set(msg.data[2]);
-
-            // Byte 3: Air Flap Target Position
-            data.air_flap_target.set(msg.data[3]);
-
-            // Byte 4: Oven State Number
-            data.oven_state_num.set(msg.data[4]);
-
-            // Byte 5: Raw byte for reference
-            data.byte281_5.set(msg.data[5]);
-
-            // Byte 6: Raw byte for reference
-            data.byte281_6.set(msg.data[6]);
-            
-            // Byte 7: Controller Version
-            data.controller_version.set(msg.data[7]);
-
-            // Debug-Ausgabe der dekodierten Werte (Added leading \n for blank line)
-            len = snprintf(
-                printBuffer, 
-                sizeof(printBuffer), 
-                "\n[CAN] Message 0x281 decoded:\n"
-                "  %-22s : %d °C\n"
-                "  %-22s : %u %%\n"
-                "  %-22s : %u %%\n"
-                "  %-22s : %u\n"
-                "  %-22s : %u\n",
-                "Combustion Temp",  data.combustion_temp.value,
-                "Air Flap Actual",  data.air_flap_act.value,
-                "Air Flap Target",  data.air_flap_target.value,
-                "Oven State Num",   data.oven_state_num.value,
-                "Controller Ver",   data.controller_version.value
-            );
-            Serial.print(printBuffer);
-            break;
-        } 
-
-        case 0x283: {
-            uint8_t message_type = msg.data[0];
-            
-            switch (message_type) {
-                case 1: { // Use braces for the inner case to guarantee scope
-                    // Byte 1 & 2: Max Combustion Temperature (16-bit, LSB first in °C)
-                    data.max_combustion_temp.set((int16_t)decodeUInt16(msg.data + 1, 2));
-                    
-                    // Byte 3 & 4: Grundglut Temperature (16-bit, LSB first in °C)
-                    data.smoldering_temp.set((int16_t)decodeUInt16(msg.data + 3, 2));
-
-                    // Byte 5: Trend
-                    data.trend.set((int8_t)msg.data[5]); 
-
-                    // Byte 6: Store raw byte for reference
-                    data.byte283_1_6.set(msg.data[6]);
-                    
-                    // Debug-Ausgabe der dekodierten Werte
-                    len = snprintf(
-                        printBuffer, 
-                        sizeof(printBuffer), 
-                        "\n[CAN] Message 0x283 Type 1 decoded:\n"
-                        "  %-22s : %d °C\n"
-                        "  %-22s : %d °C\n"
-                        "  %-22s : %d\n",
-                        "Max Combustion Temp", data.max_combustion_temp.value,
-                        "Smoldering Temp",     data.smoldering_temp.value,
-                        "Trend",               data.trend.value
-                    );
-                    Serial.print(printBuffer);
-                    break;
-                }
-                    
-                case 2: { // Statistics Data (Cycles, Errors)
-
-                    // Byte 1 & 2: Unkown Counter
-                    data.unknown_counter.set(decodeUInt16(msg.data + 1, 2));
-
-                    
-                    // Byte 3 & 4: Burn Cycles
-                    data.burn_cycles.set(decodeUInt16(msg.data + 3, 2));
-
-                    // Byte 5 & 6: Heating Error Count
-                    data.heating_error_count.set(decodeUInt16(msg.data + 5, 2));
-
-                    // Debug-Ausgabe der dekodierten Werte für 0x283 Type 2
-                    len = snprintf(
-                        printBuffer, 
-                        sizeof(printBuffer), 
-                        "\n[CAN] Message 0x283 Type 2 decoded:\n"
-                        "  %-22s : %u\n"
-                        "  %-22s : %u\n"
-                        "  %-22s : %u\n",
-                        "Unknown Counter",       data.unknown_counter.value,
-                        "Burn Cycles",           data.burn_cycles.value,
-                        "Heating Error Count",   data.heating_error_count.value
-                    );
-                    Serial.print(printBuffer);
-                    break;
-                }
-
-                case 3: { // TBD/Diagnostics Data
-
-                    // Byte 1 & 2: Heating Errors
-                    data.byte283_3_1.set(msg.data[1]);
-                    data.byte283_3_2.set(msg.data[2]);
-                    
-                    // Byte 3-6: Raw bytes
-                    data.byte283_3_3.set(msg.data[3]);
-                    data.byte283_3_4.set(msg.data[4]);
-                    data.byte283_3_5.set(msg.data[5]);
-                    data.byte283_3_6.set(msg.data[6]);
-                    
-                    // Debug-Ausgabe der dekodierten Werte für 0x283 Type 3
-                    len = snprintf(
-                        printBuffer, 
-                        sizeof(printBuffer), 
-                        "\n[CAN] Message 0x283 Type 3 decoded:\n"
-                        "  %-22s : 0x%02X\n"
-                        "  %-22s : 0x%02X\n"
-                        "  %-22s : 0x%02X\n"
-                        "  %-22s : 0x%02X\n"
-                        "  %-22s : 0x%02X\n"
-                        "  %-22s : 0x%02X\n",
-                        "Raw Byte 1", data.byte283_3_1.value,
-                        "Raw Byte 2", data.byte283_3_2.value,
-                        "Raw Byte 3", data.byte283_3_3.value,
-                        "Raw Byte 4", data.byte283_3_4.value,
-                        "Raw Byte 5", data.byte283_3_5.value,
-                        "Raw Byte 6", data.byte283_3_6.value
-                    );
-                    Serial.print(printBuffer);
-                    break;
-                }
-
-                default:
-                    Serial.print("Unrecognized 0x283 Type: ");
-                    Serial.println(msg.data[0]);
-                    break;
-            }
-        } 
-
-        default:
-            Serial.print("Unknown CAN ID: ");
-            Serial.println(msg.id, HEX);
-            break;
-    }
-}
-
-
-/**
- * @brief Verarbeitet und validiert die dekodierten CAN-Bus-Werte des Ofens.
- * * Diese Funktion führt ein Post-Processing der empfangenen Rohdaten durch:
- * - Setzt Status-Flags für Heizbetrieb und Fehlerzustände.
- * - Überwacht die Verbrennungstemperatur mit einer Hysterese 
- * - Übersetzt den numerischen Ofenstatus (oven_state_num) in einen menschenlesbaren Text.
- */
-void LEDAProtocol::runPostProcessing(Data &data) {
-    uint8_t s = data.oven_state_num.value;
-    int16_t temp = data.combustion_temp.value;
-
-    // 1. Status-Text Zuordnung
-    const char* text = getOvenStateText(s);
-    if (strcmp(data.oven_state_text, text) != 0) {
-        strncpy(data.oven_state_text, text, sizeof(data.oven_state_text) - 1);
-        data.oven_state_text[sizeof(data.oven_state_text) - 1] = '\0';
-        // Wir setzen hier manuell ein Flag, falls das Modul auch den Text senden soll
-    }
-
-    // 2. Logische Zustände ableiten 
-    bool isActive = (s >= 1 && s <= 4) || s == 8; 
-    data.oven_heated.set(isActive && (data.air_flap_act.value > 0));
-
-    // 3. Kritische Temperatur mit Hysterese
-    if (temp > CRITICAL_TEMPERATURE_THRESHOLD && !data.critical_temperature.value) {
-        data.critical_temperature.set(true);
-    } 
-    else if (temp < (CRITICAL_TEMPERATURE_THRESHOLD - CRITICAL_TEMPERATURE_HYSTERESIS) && data.critical_temperature.value) {
-        data.critical_temperature.set(false);
-    }
-
-    // 4. Fehler-Flags
-    data.heating_error.set(s == 97 || s == 99); // Beispielhafte Fehler-IDs
-    data.ember_bed.set(s == 7); // Grundglut
-}
-
-const char* LEDAProtocol::getOvenStateText(uint8_t code) {
-    switch (code) {
-        case 0:  return "Bereit";
-        case 1:  return "Start";
-        case 2:
-        case 3:  return "Anheizen";
-        case 4:  return "Heizbetrieb";
-        case 5:  return "Ende";
-        case 6:  return "Pause";
-        case 7:  return "Grundglut";
-        case 8:  return "Nachlegen";
-        case 97: return "Anheizfehler";
-        case 99: return "Sicherheitsaus";
-        default: return "Unbekannt";
-    }
-}
\ No newline at end of file
+#include "LEDAProtocol.h"
+#include "LedaLog.h"
+#include "LedaProfile.h"
+#include "OvenStateText.h"
+#include <Arduino.h>
+
+// Schwellenwerte für die Logik (wie im alten can_handler)
+const int16_t CRITICAL_TEMPERATURE_THRESHOLD = 750;
+const int16_t CRITICAL_TEMPERATURE_HYSTERESIS = 10;
+
+// Eingänge der abgeleiteten Werte (runPostProcessing)
+static constexpr uint32_t POST_PROCESSING_INPUTS = DataField::bit(DataField::OvenStateNum) |
+                                                   DataField::bit(DataField::CombustionTemp) |
+                                                   DataField::bit(DataField::AirFlapAct);
+
+/**
+ * @brief Abgeleitete Felder, deren Eingänge bereits empfangen wurden (für Data::valid).
+ */
+static constexpr uint32_t derivedValid(uint32_t valid) {
+    uint32_t derived = 0;
+    if (valid & DataField::bit(DataField::OvenStateNum))
+        derived |= DataField::bit(DataField::OvenStateText) | DataField::bit(DataField::HeatingError) |
+                   DataField::bit(DataField::EmberBed);
+    if ((valid & DataField::bit(DataField::OvenStateNum)) && (valid & DataField::bit(DataField::AirFlapAct)))
+        derived |= DataField::bit(DataField::OvenHeated);
+    if (valid & DataField::bit(DataField::CombustionTemp))
+        derived |= DataField::bit(DataField::CriticalTemperature);
+    return derived;
+}
+
+// --- Dekodier-Tabelle ---
+// Jede Zeile beschreibt ein Feld: CAN-ID, Subtyp, Offset, Breite, Vorzeichen, Ziel in Data.
+// Neue LEDA-Nachrichten werden nur hier ergänzt, der Kontrollfluss bleibt unverändert.
+
+using Frame281 = FrameDesc<0x281, -1,
+    FieldDesc<0x281, -1, 0, 2, true,  &Data::combustion_temp>,      // Byte 0-1: Verbrennungstemperatur °C
+    FieldDesc<0x281, -1, 2, 1, false, &Data::air_flap_act>,         // Byte 2: Luftklappe Ist
+    FieldDesc<0x281, -1, 3, 1, false, &Data::air_flap_target>,      // Byte 3: Luftklappe Soll
+    FieldDesc<0x281, -1, 4, 1, false, &Data::oven_state_num>,       // Byte 4: Ofen Status
+    FieldDesc<0x281, -1, 5, 1, false, &Data::byte281_5>,            // Byte 5: Rohwert
+    FieldDesc<0x281, -1, 6, 1, false, &Data::byte281_6>,            // Byte 6: Rohwert
+    FieldDesc<0x281, -1, 7, 1, false, &Data::controller_version>>;  // Byte 7: Controller Version
+
+using Frame283Type1 = FrameDesc<0x283, 1,
+    FieldDesc<0x283, 1, 1, 2, true,  &Data::max_combustion_temp>,   // Byte 1-2: Max. Verbrennungstemperatur °C
+    FieldDesc<0x283, 1, 3, 2, true,  &Data::smoldering_temp>,       // Byte 3-4: Grundglut Temperatur °C
+    FieldDesc<0x283, 1, 5, 1, true,  &Data::trend>,                 // Byte 5: Trend
+    FieldDesc<0x283, 1, 6, 1, false, &Data::byte283_1_6>>;          // Byte 6: Rohwert
+
+using Frame283Type2 = FrameDesc<0x283, 2,
+    FieldDesc<0x283, 2, 1, 2, false, &Data::unknown_counter>,       // Byte 1-2: Unbekannter Zähler
+    FieldDesc<0x283, 2, 3, 2, false, &Data::burn_cycles>,           // Byte 3-4: Abbrandzyklen
+    FieldDesc<0x283, 2, 5, 2, false, &Data::heating_error_count>>;  // Byte 5-6: Heizfehler Zähler
+
+using Frame283Type3 = FrameDesc<0x283, 3,
+    FieldDesc<0x283, 3, 1, 1, false, &Data::byte283_3_1>,           // Byte 1-6: Rohwerte (Diagnose)
+    FieldDesc<0x283, 3, 2, 1, false, &Data::byte283_3_2>,
+    FieldDesc<0x283, 3, 3, 1, false, &Data::byte283_3_3>,
+    FieldDesc<0x283, 3, 4, 1, false, &Data::byte283_3_4>,
+    FieldDesc<0x283, 3, 5, 1, false, &Data::byte283_3_5>,
+    FieldDesc<0x283, 3, 6, 1, false, &Data::byte283_3_6>>;
+
+// Debug-Ausgaben sind nur enthalten, wenn LEDA_LOG_DECODE auf Debug-Level einkompiliert ist
+#if LEDA_LOG_ENABLED(LEDA_LOG_LEVEL_DEBUG, LEDA_LOG_DECODE)
+static void print281(const Data &data);
+static void print283Type1(const Data &data);
+static void print283Type2(const Data &data);
+static void print283Type3(const Data &data);
+    #define LEDA_DECODE_PRINT(fn) fn
+#else
+    #define LEDA_DECODE_PRINT(fn) nullptr
+#endif
+
+template<typename Frame>
+static constexpr FrameEntry makeEntry(void (*print)(const Data &)) {
+    return { Frame::canId, Frame::subType, Frame::minLen, Frame::fields, &Frame::decode, print };
+}
+
+static constexpr FrameEntry FRAME_TABLE[] = {
+    makeEntry<Frame281>(LEDA_DECODE_PRINT(print281)),
+    makeEntry<Frame283Type1>(LEDA_DECODE_PRINT(print283Type1)),
+    makeEntry<Frame283Type2>(LEDA_DECODE_PRINT(print283Type2)),
+    makeEntry<Frame283Type3>(LEDA_DECODE_PRINT(print283Type3)),
+};
+
+static constexpr uint8_t FRAME_COUNT = sizeof(FRAME_TABLE) / sizeof(FRAME_TABLE[0]);
+
+/**
+ * @brief Eindeutige CAN-IDs der Tabelle, zur Compile-Zeit ermittelt.
+ */
+struct IdList {
+    uint16_t ids[FRAME_COUNT];
+    uint8_t count;
+};
+
+static constexpr IdList DECODED_IDS = []() {
+    IdList list{};
+    for (const FrameEntry &entry : FRAME_TABLE) {
+        bool known = false;
+        for (uint8_t i = 0; i < list.count; i++)
+            known |= (list.ids[i] == entry.canId);
+        if (!known) list.ids[list.count++] = entry.canId;
+    }
+    return list;
+}();
+
+uint8_t LEDAProtocol::decodedIdCount() {
+    return DECODED_IDS.count;
+}
+
+uint16_t LEDAProtocol::decodedId(uint8_t index) {
+    return DECODED_IDS.ids[index];
+}
+
+/**
+ * @brief Direktzugriff auf FRAME_TABLE über (CAN-ID - ID_BASE) und Subtyp, zur Compile-Zeit aufgebaut.
+ * Einträge ohne Subtyp stehen in plain, -1 steht für "kein Eintrag".
+ */
+static constexpr uint16_t ID_BASE = []() {
+    uint16_t base = FRAME_TABLE[0].canId;
+    for (const FrameEntry &entry : FRAME_TABLE)
+        if (entry.canId < base) base = entry.canId;
+    return base;
+}();
+
+static constexpr uint16_t ID_SPAN = []() {
+    uint16_t span = 0;
+    for (const FrameEntry &entry : FRAME_TABLE)
+        if (entry.canId - ID_BASE + 1 > span) span = entry.canId - ID_BASE + 1;
+    return span;
+}();
+
+static constexpr uint8_t SUBTYPE_SPAN = []() {
+    uint8_t span = 1;
+    for (const FrameEntry &entry : FRAME_TABLE)
+        if (entry.subType + 1 > span) span = entry.subType + 1;
+    return span;
+}();
+
+static_assert(ID_SPAN <= 16 && SUBTYPE_SPAN <= 16, "Dekodierte IDs/Subtypen zu weit gestreut für den Direktzugriff");
+
+struct FrameIndex {
+    int8_t plain[ID_SPAN];
+    int8_t sub[ID_SPAN][SUBTYPE_SPAN];
+};
+
+static constexpr FrameIndex FRAME_INDEX = []() {
+    FrameIndex index{};
+    for (uint16_t i = 0; i < ID_SPAN; i++) {
+        index.plain[i] = -1;
+        for (uint8_t s = 0; s < SUBTYPE_SPAN; s++) index.sub[i][s] = -1;
+    }
+    // Rückwärts, damit bei Dopplungen wie bisher der erste Tabelleneintrag gewinnt
+    for (int8_t e = FRAME_COUNT - 1; e >= 0; e--) {
+        const FrameEntry &entry = FRAME_TABLE[e];
+        if (entry.subType >= 0) index.sub[entry.canId - ID_BASE][entry.subType] = e;
+        else                    index.plain[entry.canId - ID_BASE] = e;
+    }
+    return index;
+}();
+
+/**
+ * @brief Sucht den passenden Tabelleneintrag für CAN-ID und Subtyp (Byte 0).
+ * @return Eintrag oder nullptr, falls der Frame nicht bekannt ist.
+ */
+const FrameEntry *LEDAProtocol::findFrame(const CANMessage &msg) {
+    const uint32_t slot = msg.id - ID_BASE;     // IDs unter ID_BASE laufen über und fallen heraus
+    if (slot >= ID_SPAN) return nullptr;
+    if (msg.len >= 1 && msg.data[0] < SUBTYPE_SPAN) {
+        const int8_t e = FRAME_INDEX.sub[slot][msg.data[0]];
+        if (e >= 0) return &FRAME_TABLE[e];
+    }
+    const int8_t e = FRAME_INDEX.plain[slot];
+    return (e >= 0) ? &FRAME_TABLE[e] : nullptr;
+}
+
+/**
+ * @brief Processes and decodes a received CAN message based on its ID.
+ *
+ * @param msg The CAN message object.
+ * @param data Reference to the Data structure to update.
+ * @param update Optional: fields contained in / changed by this frame.
+ * @return true if the message ID and type were recognized and processed, false otherwise
+ *         (also for remote frames).
+ */
+bool LEDAProtocol::parseFrame(const CANMessage &msg, Data &data, FrameUpdate *update) {
+    // Remote-Frames (z.B. fremder Knoten im Diagnose-Modus) tragen keine Nutzdaten
+    if (msg.rtr) {
+        ledaLogInfo(LEDA_LOG_PROTO, "Remote frame ignored: %X", (unsigned)msg.id);
+        return false;
+    }
+    const FrameEntry *entry = findFrame(msg);
+    if (entry == nullptr) {
+        if (msg.id == 0x283 && msg.len >= 1)
+            ledaLogInfo(LEDA_LOG_PROTO, "Unrecognized 0x283 Type: %u", msg.data[0]);
+        else if (msg.id == 0x283)
+            ledaLogInfo(LEDA_LOG_PROTO, "0x283 without type byte");
+        else
+            ledaLogInfo(LEDA_LOG_PROTO, "Unknown CAN ID: %X", (unsigned)msg.id);
+        return false;
+    }
+
+    if (msg.len < entry->minLen) {
+        ledaLogError(LEDA_LOG_PROTO, "ERROR: Frame too short for ID 0x%X", (unsigned)msg.id);
+        return false;
+    }
+
+    // Nur die von diesem Frame geänderten Felder lösen die Ableitung aus
+    const uint32_t pending = data.dirty;
+    data.dirty = 0;
+    entry->decode(msg.data, data);
+    const uint32_t updated = data.dirty;
+    data.dirty |= pending;
+    if (updated & POST_PROCESSING_INPUTS) {
+        LEDA_PROFILE_SCOPE(ProfileStage::PostProcess);
+        runPostProcessing(data, updated);
+    }
+    data.valid |= entry->fields;
+    data.valid |= derivedValid(data.valid);
+    if (update != nullptr)
+        *update = { entry->fields, updated };
+#if LEDA_LOG_ENABLED(LEDA_LOG_LEVEL_DEBUG, LEDA_LOG_DECODE)
+    if (LedaLog::active(LEDA_LOG_LEVEL_DEBUG, LEDA_LOG_DECODE))
+        entry->print(data);
+#endif
+    return true;
+}
+
+// --- Debug-Ausgaben der dekodierten Werte ---
+#if LEDA_LOG_ENABLED(LEDA_LOG_LEVEL_DEBUG, LEDA_LOG_DECODE)
+static void print281(const Data &data) {
+    LedaLog::write(
+        LEDA_LOG_LEVEL_DEBUG,
+        LEDA_LOG_DECODE,
+        "[CAN] Message 0x281 decoded:\n"
+        "  %-22s : %d °C\n"
+        "  %-22s : %u %%\n"
+        "  %-22s : %u %%\n"
+        "  %-22s : %u\n"
+        "  %-22s : %u",
+        "Combustion Temp",  data.combustion_temp.value,
+        "Air Flap Actual",  data.air_flap_act.value,
+        "Air Flap Target",  data.air_flap_target.value,
+        "Oven State Num",   data.oven_state_num.value,
+        "Controller Ver",   data.controller_version.value
+    );
+}
+
+static void print283Type1(const Data &data) {
+    LedaLog::write(
+        LEDA_LOG_LEVEL_DEBUG,
+        LEDA_LOG_DECODE,
+        "[CAN] Message 0x283 Type 1 decoded:\n"
+        "  %-22s : %d °C\n"
+        "  %-22s : %d °C\n"
+        "  %-22s : %d",
+        "Max Combustion Temp", data.max_combustion_temp.value,
+        "Smoldering Temp",     data.smoldering_temp.value,
+        "Trend",               data.trend.value
+    );
+}
+
+static void print283Type2(const Data &data) {
+    LedaLog::write(
+        LEDA_LOG_LEVEL_DEBUG,
+        LEDA_LOG_DECODE,
+        "[CAN] Message 0x283 Type 2 decoded:\n"
+        "  %-22s : %u\n"
+        "  %-22s : %u\n"
+        "  %-22s : %u",
+        "Unknown Counter",       data.unknown_counter.value,
+        "Burn Cycles",           data.burn_cycles.value,
+        "Heating Error Count",   data.heating_error_count.value
+    );
+}
+
+static void print283Type3(const Data &data) {
+    LedaLog::write(
+        LEDA_LOG_LEVEL_DEBUG,
+        LEDA_LOG_DECODE,
+        "[CAN] Message 0x283 Type 3 decoded:\n"
+        "  %-22s : 0x%02X\n"
+        "  %-22s : 0x%02X\n"
+        "  %-22s : 0x%02X\n"
+        "  %-22s : 0x%02X\n"
+        "  %-22s : 0x%02X\n"
+        "  %-22s : 0x%02X",
+        "Raw Byte 1", data.byte283_3_1.value,
+        "Raw Byte 2", data.byte283_3_2.value,
+        "Raw Byte 3", data.byte283_3_3.value,
+        "Raw Byte 4", data.byte283_3_4.value,
+        "Raw Byte 5", data.byte283_3_5.value,
+        "Raw Byte 6", data.byte283_3_6.value
+    );
+}
+#endif
+
+
+/**
+ * @brief Leitet abhängige Werte aus den dekodierten CAN-Bus-Werten des Ofens ab.
+ * Es wird nur neu berechnet, was von einem geänderten Eingang abhängt; abgeleitete
+ * Felder setzen dabei selbst ihr Dirty-Bit und gehen im selben Durchlauf an KNX.
+ * - Setzt Status-Flags für Heizbetrieb und Fehlerzustände.
+ * - Überwacht die Verbrennungstemperatur mit einer Hysterese 
+ * - Übersetzt den numerischen Ofenstatus (oven_state_num) in einen menschenlesbaren Text.
+ *
+ * @param updated Dirty-Bits der durch den aktuellen Frame geänderten Felder
+ */
+void LEDAProtocol::runPostProcessing(Data &data, uint32_t updated) {
+    uint8_t s = data.oven_state_num.value;
+    int16_t temp = data.combustion_temp.value;
+    bool stateChanged = updated & DataField::bit(DataField::OvenStateNum);
+
+    // 1. Status-Text Zuordnung
+    if (stateChanged) {
+        // Texte sind interniert: gleicher Text = gleicher Pointer
+        const char* text = OvenStateText::get(s);
+        if (data.oven_state_text != text) {
+            data.oven_state_text = text;
+            data.markDirty(DataField::OvenStateText);
+        }
+    }
+
+    // 2. Logische Zustände ableiten 
+    if (updated & (DataField::bit(DataField::OvenStateNum) | DataField::bit(DataField::AirFlapAct))) {
+        bool isActive = (s >= 1 && s <= 4) || s == 8; 
+        data.set<&Data::oven_heated>(isActive && (data.air_flap_act.value > 0));
+    }
+
+    // 3. Kritische Temperatur mit Hysterese
+    if (updated & DataField::bit(DataField::CombustionTemp)) {
+        if (temp > CRITICAL_TEMPERATURE_THRESHOLD && !data.critical_temperature.value) {
+            data.set<&Data::critical_temperature>(true);
+        } 
+        else if (temp < (CRITICAL_TEMPERATURE_THRESHOLD - CRITICAL_TEMPERATURE_HYSTERESIS) && data.critical_temperature.value) {
+            data.set<&Data::critical_temperature>(false);
+        }
+    }
+
+    // 4. Fehler-Flags
+    if (stateChanged) {
+        data.set<&Data::heating_error>(s == 97 || s == 99); // Beispielhafte Fehler-IDs
+        data.set<&Data::ember_bed>(s == 7); // Grundglut
+    }
+}
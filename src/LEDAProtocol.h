@@ -1,12 +1,98 @@
-#pragma once
-
-#include <ACAN2515.h>
-#include "DataModel.h"
-
-class LEDAProtocol {
-public:
-    static void parseFrame(const CANMessage &msg, Data &data);
-private:
-    static void runPostProcessing(Data &data);
-    static const char* getOvenStateText(uint8_t code);
-};
\ No newline at end of file
+#pragma once
+
+#include <ACAN2515.h>
+#include "DataModel.h"
+
+/**
+ * @brief Beschreibt ein einzelnes Feld innerhalb eines LEDA-Frames.
+ *
+ * Alle Angaben sind Template-Parameter, damit der Compiler pro Feld genau
+ * einen Lese- und einen set()-Aufruf erzeugt (keine Laufzeit-Verzweigung).
+ *
+ * @tparam CanId   CAN-ID des Frames
+ * @tparam SubType Wert von Byte 0 (Nachrichtentyp) oder -1, falls der Frame keinen Subtyp hat
+ * @tparam Offset  Byte-Offset im Frame
+ * @tparam Width   Breite in Bytes (1 oder 2, Little-Endian)
+ * @tparam Signed  Vorzeichenbehaftete Interpretation
+ * @tparam Member  Ziel-Feld in Data (Pointer-to-Member)
+ */
+template<uint16_t CanId, int16_t SubType, uint8_t Offset, uint8_t Width, bool Signed, auto Member>
+struct FieldDesc {
+    static_assert(Width == 1 || Width == 2, "Nur 8- und 16-Bit Felder werden unterstützt");
+    static_assert(Offset + Width <= 8, "Feld liegt außerhalb der 8 Datenbytes");
+
+    static constexpr uint16_t canId = CanId;
+    static constexpr int16_t subType = SubType;
+    static constexpr uint8_t end = Offset + Width;
+    static constexpr uint32_t mask = DataField::bit(fieldIndex<Member>);
+
+    static inline void decode(const uint8_t *d, Data &data) {
+        using ValueT = decltype((data.*Member).value);
+        if constexpr (Width == 1) {
+            if constexpr (Signed) data.set<Member>((ValueT)(int8_t)d[Offset]);
+            else                  data.set<Member>((ValueT)d[Offset]);
+        } else {
+            // Little-Endian: erstes Byte ist LSB
+            uint16_t raw = (uint16_t)((d[Offset + 1] << 8) | d[Offset]);
+            if constexpr (Signed) data.set<Member>((ValueT)(int16_t)raw);
+            else                  data.set<Member>((ValueT)raw);
+        }
+    }
+};
+
+/**
+ * @brief Fasst alle Felder eines Frames (CAN-ID + Subtyp) zusammen.
+ */
+template<uint16_t CanId, int16_t SubType, typename... Fields>
+struct FrameDesc {
+    static_assert(((Fields::canId == CanId && Fields::subType == SubType) && ...),
+                  "Feld gehört nicht zu diesem Frame");
+
+    static constexpr uint16_t canId = CanId;
+    static constexpr int16_t subType = SubType;
+    // Mindestlänge: Subtyp-Byte bzw. letztes belegtes Byte
+    static constexpr uint8_t minLen = []() {
+        uint8_t len = (SubType >= 0) ? 1 : 0;
+        ((len = (Fields::end > len) ? Fields::end : len), ...);
+        return len;
+    }();
+
+    // Alle Felder des Frames als DataField-Bits
+    static constexpr uint32_t fields = (Fields::mask | ...);
+
+    static void decode(const uint8_t *d, Data &data) {
+        (Fields::decode(d, data), ...);
+    }
+};
+
+/**
+ * @brief Eintrag der Laufzeit-Tabelle, wird aus einem FrameDesc erzeugt.
+ */
+struct FrameEntry {
+    uint16_t canId;
+    int16_t subType;
+    uint8_t minLen;
+    uint32_t fields;
+    void (*decode)(const uint8_t *d, Data &data);
+    void (*print)(const Data &data);
+};
+
+/**
+ * @brief Welche Felder ein Frame enthielt und welche er geändert hat (DataField-Bits).
+ */
+struct FrameUpdate {
+    uint32_t present;
+    uint32_t changed;
+};
+
+class LEDAProtocol {
+public:
+    static bool parseFrame(const CANMessage &msg, Data &data, FrameUpdate *update = nullptr);
+
+    // Menge der dekodierten CAN-IDs (aus der Dekodier-Tabelle), z.B. für Hardware-Filter
+    static uint8_t decodedIdCount();
+    static uint16_t decodedId(uint8_t index);
+private:
+    static const FrameEntry *findFrame(const CANMessage &msg);
+    static void runPostProcessing(Data &data, uint32_t updated);
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stdint.h>
+#include "DataModel.h"
+#include "DeadlineQueue.h"
+#include "SendPolicy.h"
+#include "LivenessMonitor.h"
+#include "WindowStats.h"
+#include "BurnSession.h"
+#include "SpscRing.h"
+
+// Maximale Anzahl Kanäle (LEDA-Controller am selben Bus). Die ETS-Vorlage
+// enthält so viele Kanäle, die Anzahl in Betrieb kommt aus der ETS.
+#ifndef LEDA_MAX_CHANNELS
+    #define LEDA_MAX_CHANNELS 2
+#endif
+
+// Felder mit ETS-Parameter für zyklisches Senden (Index in cycleMinutes)
+namespace CycleSlot {
+    enum : uint8_t {
+        CombustionTemp,
+        MaxCombustionTemp,
+        SmolderingTemp,
+        AirFlapAct,
+        AirFlapTarget,
+        OvenStateNum,
+        OvenStateText,
+        Trend,
+        OvenHeated,
+        Count
+    };
+}
+
+// Signale mit Fenster-Statistik
+namespace StatSignal {
+    enum : uint8_t {
+        CombustionTemp,
+        AirFlapAct,
+        Count
+    };
+}
+
+// Kennwerte eines abgeschlossenen Fensters aller Signale
+struct StatsResult {
+    WindowResult signal[StatSignal::Count];
+};
+
+struct StatsState {
+    WindowStats signal[StatSignal::Count];      // CAN-Seite: je Frame fortgeschrieben
+    uint32_t closeAt = 0;                       // CAN-Seite: Ende des laufenden Fensters
+    SpscRing<StatsResult, 2> closed;            // Übergabe abgeschlossener Fenster an den KNX-Loop
+    StatsResult result;                         // KNX-Seite: zuletzt abgeschlossenes Fenster (wird gesendet)
+};
+
+/**
+ * @brief Zustand eines Kanals, also eines LEDA-Controllers am CAN-Bus.
+ *
+ * Jeder Kanal hat ein eigenes Datenmodell, eigene Sendeparameter und Termine
+ * sowie eigene KOs (ab koBase). Seine Frames kommen auf den dekodierten IDs
+ * plus idOffset an. CAN-Hardware, Telegrammbudget und Service-Termine teilen
+ * sich alle Kanäle im CANGateway.
+ *
+ * Die CAN-Seite (ingest, liveness, Statistik-Fenster) gehört loop1, alles
+ * Übrige dem KNX-Loop. Der dekodierte Stand geht über published, abgeschlossene
+ * Statistik-Fenster über stats.closed von einer Seite zur anderen.
+ */
+struct LedaChannel {
+    uint8_t index;
+    uint16_t koBase;                    // Erstes KO des Kanals
+    uint16_t idOffset = 0;              // Versatz der CAN-IDs gegenüber 0x281/0x283
+    Data ingest;                        // CAN-Seite: wird beim Empfang dekodiert
+    SpscRing<Data, 2> published;        // Übergabe an den KNX-Loop (höchstens ein Stand unterwegs)
+    Data data;                          // KNX-Seite: zuletzt übernommener Stand
+    uint32_t known = 0;                 // Felder mit bekanntem Wert (empfangen oder aus dem Warmstart)
+    bool snapshotPending = false;       // Stand seit dem letzten Warmstart-Schreiben geändert
+    HysteresisState hysteresis;         // Zuletzt gesendete Werte und Hysterese (nur Hysterese-Felder)
+    uint32_t sendOnChange = 0;          // Senden bei Änderung je Feld (DataField-Bits)
+    uint8_t cycleMinutes[CycleSlot::Count] = {};            // Zyklus je zyklischem Feld (aus ETS, 0 = aus)
+    DeadlineQueue<CycleSlot::Count, uint16_t> cycleTimers;  // Nächster zyklischer Sendezeitpunkt (in Ticks, s. CYCLE_TICK_SHIFT)
+    DeadlineQueue<HysteresisSlot::Count> deltaTimers;       // Neubewertung nach Mindest-/Höchstabstand bzw. Drift der Vorhersage
+    LivenessMonitor liveness;           // Timeout je überwachter CAN-ID (CAN-Seite)
+    uint8_t heartbeatMinutes = 0;
+    StatsState stats;                   // Min/Max/Mittel/Steigung je Fenster
+    uint32_t statsWindowMs = 0;         // Fensterlänge (0 = Statistik aus)
+    BurnSessionTracker sessions;        // Abbrand-Sitzungen und Summen
+
+    LedaChannel(uint8_t index, uint16_t koBase) : index(index), koBase(koBase), ingest(DEFAULT_VALUES), data(DEFAULT_VALUES) {}
+};
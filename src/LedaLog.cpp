@@ -0,0 +1,109 @@
+#include "LedaLog.h"
+#include "SpscRing.h"
+#include <Arduino.h>
+#include <stdarg.h>
+#ifdef OPENKNX_DUALCORE
+    #include <pico/platform.h>
+#endif
+
+namespace LedaLog {
+    uint8_t level = LEDA_LOG_LEVEL;
+    uint8_t categories = LEDA_LOG_CATEGORIES;
+
+    // Ein Ring je Kern: jeder Ring hat genau einen Erzeuger, Verbraucher ist drain() auf Core 0
+#ifdef OPENKNX_DUALCORE
+    static constexpr uint8_t WRITERS = 2;
+    static inline uint8_t writer() { return get_core_num(); }
+#else
+    static constexpr uint8_t WRITERS = 1;
+    static inline uint8_t writer() { return 0; }
+#endif
+
+    struct Writer {
+        SpscRing<char, LEDA_LOG_RING_SIZE> ring;
+        uint32_t dropped = 0;           // Vom Erzeuger gezählt (Rate/Platz)
+        uint16_t tokens = LEDA_LOG_BURST;
+        uint32_t lastRefill = 0;
+    };
+
+    static Writer _writers[WRITERS];
+    static uint32_t _reported = 0;      // Vom Verbraucher bereits gemeldet
+    static uint8_t _draining = 0;       // Ring, aus dem drain() gerade ausgibt
+    static bool _partial = false;       // Dessen Zeile ist erst teilweise ausgegeben
+
+    // Token-Bucket je Kern: LEDA_LOG_RATE Zeilen/s, maximal LEDA_LOG_BURST am Stück
+    static bool takeToken(Writer &writer) {
+        uint32_t now = millis();
+        uint32_t refill = (now - writer.lastRefill) * LEDA_LOG_RATE / 1000;
+        if (refill > 0) {
+            writer.tokens = (writer.tokens + refill > LEDA_LOG_BURST) ? LEDA_LOG_BURST : writer.tokens + refill;
+            writer.lastRefill = now;
+        }
+        if (writer.tokens == 0) return false;
+        writer.tokens--;
+        return true;
+    }
+
+    void write(uint8_t lvl, uint8_t cat, const char *format, ...) {
+        if (!active(lvl, cat)) return;
+        Writer &self = _writers[writer()];
+        if (!takeToken(self)) {
+            self.dropped++;
+            return;
+        }
+
+        char line[256];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(line, sizeof(line) - 1, format, args);
+        va_end(args);
+        if (len < 0) return;
+        if (len > (int)sizeof(line) - 2) len = sizeof(line) - 2;
+        line[len++] = '\n';
+
+        // Nur vollständige Zeilen ablegen
+        if (self.ring.freeSpace() < len) {
+            self.dropped++;
+            return;
+        }
+        for (int i = 0; i < len; i++) self.ring.push(line[i]);
+    }
+
+    void drain() {
+        char buffer[64];
+        int space = Serial.availableForWrite();
+        uint8_t empty = 0;              // Ringe in Folge ohne neue Zeichen
+        while (space > 0 && empty < WRITERS) {
+            SpscRing<char, LEDA_LOG_RING_SIZE> &ring = _writers[_draining].ring;
+            int n = 0;
+            int max = (space < (int)sizeof(buffer)) ? space : (int)sizeof(buffer);
+            while (n < max && ring.pop(buffer[n])) {
+                _partial = buffer[n++] != '\n';
+                if (!_partial) break;
+            }
+            if (n > 0) {
+                Serial.write((const uint8_t *)buffer, n);
+                space -= n;
+                empty = 0;
+            } else if (_partial) {
+                break;                  // Rest der Zeile legt der Erzeuger gerade ab
+            } else {
+                empty++;
+            }
+            // Die Kerne kommen abwechselnd zum Zug, gewechselt wird nur an Zeilengrenzen
+            if (!_partial) _draining = (_draining + 1) % WRITERS;
+        }
+
+        uint32_t dropped = LedaLog::dropped();
+        if (dropped != _reported && empty >= WRITERS && Serial.availableForWrite() >= 48) {
+            Serial.printf("[LEDA] %u Logzeile(n) verworfen\n", (unsigned)(dropped - _reported));
+            _reported = dropped;
+        }
+    }
+
+    uint32_t dropped() {
+        uint32_t dropped = 0;
+        for (const Writer &writer : _writers) dropped += writer.dropped;
+        return dropped;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+
+// --- Log-Level ---
+#define LEDA_LOG_LEVEL_NONE   0
+#define LEDA_LOG_LEVEL_ERROR  1
+#define LEDA_LOG_LEVEL_INFO   2
+#define LEDA_LOG_LEVEL_DEBUG  3
+#define LEDA_LOG_LEVEL_TRACE  4
+
+// --- Kategorien ---
+#define LEDA_LOG_RAW     0x01  // Rohframes aus loop1
+#define LEDA_LOG_DECODE  0x02  // Dekodierte Werte je Frame
+#define LEDA_LOG_PROTO   0x04  // Unbekannte IDs, Subtypen, zu kurze Frames
+#define LEDA_LOG_SYNC    0x08  // KNX-Sendeentscheidungen
+#define LEDA_LOG_ALL     0x0F
+
+// Zur Compile-Zeit aktive Level/Kategorien. Release-Builds enthalten nur Fehler,
+// alle Debug-Ausgaben im Empfangspfad werden vollständig entfernt.
+#ifndef LEDA_LOG_LEVEL
+    #ifdef OPENKNX_DEBUG
+        #define LEDA_LOG_LEVEL LEDA_LOG_LEVEL_DEBUG
+    #else
+        #define LEDA_LOG_LEVEL LEDA_LOG_LEVEL_ERROR
+    #endif
+#endif
+
+#ifndef LEDA_LOG_CATEGORIES
+    #define LEDA_LOG_CATEGORIES LEDA_LOG_ALL
+#endif
+
+// Größe des Ringpuffers je Kern (Zweierpotenz) und Ratenbegrenzung je Kern (Zeilen pro Sekunde / Burst)
+#ifndef LEDA_LOG_RING_SIZE
+    #define LEDA_LOG_RING_SIZE 2048
+#endif
+#ifndef LEDA_LOG_RATE
+    #define LEDA_LOG_RATE 20
+#endif
+#ifndef LEDA_LOG_BURST
+    #define LEDA_LOG_BURST 40
+#endif
+
+#define LEDA_LOG_ENABLED(level, cat) ((level) <= LEDA_LOG_LEVEL && (LEDA_LOG_CATEGORIES & (cat)) != 0)
+
+/**
+ * @brief Schreibt eine Logzeile, sofern Level und Kategorie einkompiliert sind.
+ * Ist die Kombination nicht einkompiliert, werden auch die Argumente nicht ausgewertet.
+ */
+#define ledaLog(level, cat, ...)                          \
+    do {                                                  \
+        if constexpr (LEDA_LOG_ENABLED(level, cat))       \
+            LedaLog::write(level, cat, __VA_ARGS__);      \
+    } while (0)
+
+#define ledaLogError(cat, ...) ledaLog(LEDA_LOG_LEVEL_ERROR, cat, __VA_ARGS__)
+#define ledaLogInfo(cat, ...)  ledaLog(LEDA_LOG_LEVEL_INFO,  cat, __VA_ARGS__)
+#define ledaLogDebug(cat, ...) ledaLog(LEDA_LOG_LEVEL_DEBUG, cat, __VA_ARGS__)
+#define ledaLogTrace(cat, ...) ledaLog(LEDA_LOG_LEVEL_TRACE, cat, __VA_ARGS__)
+
+/**
+ * @brief Nicht blockierendes, ratenbegrenztes Logging für den Empfangspfad.
+ *
+ * Zeilen werden formatiert in einen Ringpuffer des schreibenden Kerns gelegt
+ * und erst in drain() (Leerlauf, Core 0) auf die serielle Schnittstelle
+ * ausgegeben. write() ist damit von beiden Kernen aus sperrfrei aufrufbar.
+ * Level und Kategorien sind zur Laufzeit über die Konsole umschaltbar.
+ */
+namespace LedaLog {
+    extern uint8_t level;
+    extern uint8_t categories;
+
+    inline bool active(uint8_t lvl, uint8_t cat) { return lvl <= level && (categories & cat); }
+
+    void write(uint8_t lvl, uint8_t cat, const char *format, ...) __attribute__((format(printf, 3, 4)));
+    void drain();
+    uint32_t dropped();
+}
@@ -0,0 +1,109 @@
+#include "LedaProfile.h"
+
+#if LEDA_PROFILE_ENABLED
+#include <Arduino.h>
+
+namespace LedaProfile {
+
+static StageTiming stages[ProfileStage::Count];
+static uint16_t frameIds[LEDA_PROFILE_ID_SLOTS];
+static uint32_t frameCounts[LEDA_PROFILE_ID_SLOTS];
+static uint8_t frameSlots = 0;
+static uint32_t otherFrameCount = 0;
+static uint32_t unknownIdCount = 0;
+static uint32_t unknownSubtypeCount = 0;
+static uint32_t telegramCounts[LEDA_PROFILE_KO_COUNT];
+static uint32_t startedAt = 0;
+
+uint32_t cycles() {
+    return rp2040.getCycleCount();
+}
+
+uint32_t cyclesPerMicrosecond() {
+    return rp2040.f_cpu() / 1000000;
+}
+
+void record(uint8_t stage, uint32_t cycles) {
+    StageTiming &timing = stages[stage];
+    if (timing.count == 0 || cycles < timing.min) timing.min = cycles;
+    if (cycles > timing.max) timing.max = cycles;
+    timing.sum += cycles;
+    timing.count++;
+}
+
+void countFrame(uint16_t id) {
+    // Wenige IDs am Bus: lineare Suche über die belegten Plätze
+    for (uint8_t i = 0; i < frameSlots; i++) {
+        if (frameIds[i] == id) {
+            frameCounts[i]++;
+            return;
+        }
+    }
+    if (frameSlots < LEDA_PROFILE_ID_SLOTS) {
+        frameIds[frameSlots] = id;
+        frameCounts[frameSlots] = 1;
+        frameSlots++;
+        return;
+    }
+    otherFrameCount++;
+}
+
+void countUnknownId() {
+    unknownIdCount++;
+}
+
+void countUnknownSubtype() {
+    unknownSubtypeCount++;
+}
+
+void countTelegram(uint16_t ko) {
+    if (ko < LEDA_PROFILE_KO_COUNT)
+        telegramCounts[ko]++;
+}
+
+void reset() {
+    for (StageTiming &timing : stages)
+        timing = {};
+    for (uint8_t i = 0; i < frameSlots; i++)
+        frameCounts[i] = 0;
+    otherFrameCount = 0;
+    unknownIdCount = 0;
+    unknownSubtypeCount = 0;
+    for (uint32_t &count : telegramCounts)
+        count = 0;
+    startedAt = millis();
+}
+
+const StageTiming &stage(uint8_t stage) {
+    return stages[stage];
+}
+
+bool frames(uint8_t slot, uint16_t &id, uint32_t &count) {
+    if (slot >= frameSlots) return false;
+    id = frameIds[slot];
+    count = frameCounts[slot];
+    return true;
+}
+
+uint32_t otherFrames() {
+    return otherFrameCount;
+}
+
+uint32_t unknownIds() {
+    return unknownIdCount;
+}
+
+uint32_t unknownSubtypes() {
+    return unknownSubtypeCount;
+}
+
+uint32_t telegrams(uint16_t ko) {
+    return ko < LEDA_PROFILE_KO_COUNT ? telegramCounts[ko] : 0;
+}
+
+uint32_t since() {
+    return startedAt;
+}
+
+}
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <stdint.h>
+
+// Laufzeitmessung und Zähler im Hot-Path einkompilieren (ca. 470 Byte RAM)
+#ifndef LEDA_PROFILE_ENABLED
+    #define LEDA_PROFILE_ENABLED 0
+#endif
+
+// Anzahl getrennt gezählter CAN-IDs, weitere landen in otherFrames()
+#ifndef LEDA_PROFILE_ID_SLOTS
+    #define LEDA_PROFILE_ID_SLOTS 8
+#endif
+
+// Gezählte KOs (Telegramme je KO, ab KO 0)
+#ifndef LEDA_PROFILE_KO_COUNT
+    #define LEDA_PROFILE_KO_COUNT 76
+#endif
+
+// Gemessene Stufen der Verarbeitung
+namespace ProfileStage {
+    enum : uint8_t {
+        Receive,        // Empfangsring leeren (ein Durchlauf mit Frames, inkl. Dekodierung)
+        Decode,         // LEDAProtocol::parseFrame je Frame (inkl. Ableitung)
+        PostProcess,    // Abgeleitete Werte
+        Sync,           // syncDataToKNX je Kanal mit anstehenden Feldern
+        Count
+    };
+}
+
+/**
+ * @brief Min/Mittel/Max einer Stufe in CPU-Takten.
+ */
+struct StageTiming {
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t count;
+};
+
+/**
+ * @brief Instrumentierung des Hot-Path: Laufzeit je Stufe, Frames je CAN-ID,
+ * unbekannte Frames und Telegramme je KO.
+ *
+ * Im Betrieb schreibt jeden Zähler nur ein Kern (Receive/Decode/PostProcess
+ * und Frames auf der CAN-Seite, Sync und Telegramme auf der KNX-Seite), daher
+ * ohne Sperren. Die Ausgabe liest ohne Abgleich, einzelne Werte können um
+ * einen Frame auseinanderliegen. "leda bench" und das Replay der Aufzeichnung
+ * fließen in PostProcess/Sync mit ein. Ist LEDA_PROFILE_ENABLED 0, entfallen
+ * die Aufrufe vollständig.
+ */
+namespace LedaProfile {
+
+#if LEDA_PROFILE_ENABLED
+    // Taktzähler des aufrufenden Kerns
+    uint32_t cycles();
+    uint32_t cyclesPerMicrosecond();
+
+    void record(uint8_t stage, uint32_t cycles);
+    void countFrame(uint16_t id);
+    void countUnknownId();
+    void countUnknownSubtype();
+    void countTelegram(uint16_t ko);
+
+    // Setzt alle Zähler zurück (Konsole, Werte der anderen Seite können einen Frame nachlaufen)
+    void reset();
+
+    const StageTiming &stage(uint8_t stage);
+    // Frames je ID: false, wenn der Platz unbelegt ist
+    bool frames(uint8_t slot, uint16_t &id, uint32_t &count);
+    uint32_t otherFrames();
+    uint32_t unknownIds();
+    uint32_t unknownSubtypes();
+    uint32_t telegrams(uint16_t ko);
+    // Beginn der Zählung (millis)
+    uint32_t since();
+
+    /**
+     * @brief Misst einen Block bis zum Ende des Gültigkeitsbereichs.
+     */
+    struct Scope {
+        uint8_t stage;
+        uint32_t start;
+        explicit Scope(uint8_t stage) : stage(stage), start(cycles()) {}
+        ~Scope() { record(stage, cycles() - start); }
+    };
+#else
+    inline void countFrame(uint16_t) {}
+    inline void countUnknownId() {}
+    inline void countUnknownSubtype() {}
+    inline void countTelegram(uint16_t) {}
+#endif
+}
+
+#if LEDA_PROFILE_ENABLED
+    #define LEDA_PROFILE_SCOPE(stage) LedaProfile::Scope _ledaProfileScope(stage)
+#else
+    #define LEDA_PROFILE_SCOPE(stage)
+#endif
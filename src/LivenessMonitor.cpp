@@ -0,0 +1,36 @@
+#include "LivenessMonitor.h"
+
+void LivenessMonitor::watch(uint16_t canId, uint32_t timeoutMs, uint32_t now) {
+    if (timeoutMs == 0 || _count >= LEDA_LIVENESS_MAX_IDS) return;
+    const uint8_t index = _count++;
+    _ids[index] = canId;
+    _timeout[index] = timeoutMs;
+    _watched |= (1 << index);
+    // Bleibt die ID schon nach dem Start aus, gilt sie nach dem Timeout als verloren
+    _timers.schedule(index, now + timeoutMs);
+}
+
+bool LivenessMonitor::onFrame(uint16_t canId, uint32_t now) {
+    for (uint8_t index = 0; index < _count; index++) {
+        if (_ids[index] != canId) continue;
+
+        _timers.schedule(index, now + _timeout[index]);
+        const uint8_t bit = 1 << index;
+        if ((_alive & bit) && !(_expired & bit)) return false;
+        _alive |= bit;
+        _expired &= ~bit;
+        return true;
+    }
+    return false;
+}
+
+bool LivenessMonitor::check(uint32_t now) {
+    bool changed = false;
+    while (_timers.due(now)) {
+        const uint8_t bit = 1 << _timers.pop();
+        _alive &= ~bit;
+        _expired |= bit;
+        changed = true;
+    }
+    return changed;
+}
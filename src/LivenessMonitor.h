@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+#include "DeadlineQueue.h"
+
+// Maximale Anzahl überwachter CAN-IDs
+#ifndef LEDA_LIVENESS_MAX_IDS
+    #define LEDA_LIVENESS_MAX_IDS 4
+#endif
+
+/**
+ * @brief Überwacht, ob die erwarteten CAN-IDs regelmäßig empfangen werden.
+ *
+ * Je ID läuft ein Timeout in einer DeadlineQueue. Ein Frame verschiebt den
+ * Termin, geprüft wird nur, wenn der nächste Termin erreicht ist.
+ */
+class LivenessMonitor {
+public:
+    /**
+     * @brief Nimmt eine ID in die Überwachung auf.
+     * @param timeoutMs Zeit ohne Frame, nach der die ID als verloren gilt (0 = nicht überwachen)
+     */
+    void watch(uint16_t canId, uint32_t timeoutMs, uint32_t now);
+
+    /**
+     * @brief Meldet einen empfangenen Frame.
+     * @return true, wenn sich online() oder lost() geändert hat.
+     */
+    bool onFrame(uint16_t canId, uint32_t now);
+
+    /**
+     * @brief Verarbeitet abgelaufene Timeouts.
+     * @return true, wenn sich online() oder lost() geändert hat.
+     */
+    bool check(uint32_t now);
+
+    bool due(uint32_t now) const { return _timers.due(now); }
+    bool pending() const { return !_timers.empty(); }
+    uint32_t nextDeadline() const { return _timers.next(); }
+
+    // Alle überwachten IDs innerhalb ihres Timeouts empfangen
+    bool online() const { return _watched != 0 && _alive == _watched; }
+    // Mindestens eine überwachte ID ist ausgeblieben
+    bool lost() const { return _expired != 0; }
+
+private:
+    uint16_t _ids[LEDA_LIVENESS_MAX_IDS];
+    uint32_t _timeout[LEDA_LIVENESS_MAX_IDS];
+    uint8_t _count = 0;
+    uint8_t _watched = 0;   // Bitmasken je Index
+    uint8_t _alive = 0;
+    uint8_t _expired = 0;
+    DeadlineQueue<LEDA_LIVENESS_MAX_IDS> _timers;
+};
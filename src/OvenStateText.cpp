@@ -0,0 +1,122 @@
+#include "OvenStateText.h"
+
+namespace OvenStateText {
+
+static constexpr uint8_t PAYLOAD_SIZE = DPT16_LENGTH + 1;
+
+struct KnownState {
+    uint8_t code;
+    const char *text[LanguageCount];
+};
+
+// Bekannte Statuscodes der LEDA-Steuerung
+static constexpr KnownState KNOWN_STATES[] = {
+    {0,  {"Bereit",         "Ready"}},
+    {1,  {"Start",          "Start"}},
+    {2,  {"Anheizen",       "Heating up"}},
+    {3,  {"Anheizen",       "Heating up"}},
+    {4,  {"Heizbetrieb",    "Heating"}},
+    {5,  {"Ende",           "Finished"}},
+    {6,  {"Pause",          "Pause"}},
+    {7,  {"Grundglut",      "Ember bed"}},
+    {8,  {"Nachlegen",      "Add wood"}},
+    {97, {"Anheizfehler",   "Ignition error"}},
+    {99, {"Sicherheitsaus", "Safety cutoff"}},
+};
+
+static constexpr const char *UNKNOWN_PREFIX[LanguageCount] = {"Unbekannt", "Unknown"};
+static constexpr const char *INITIAL[LanguageCount] = {"Initialisieren", "Starting"};
+
+/**
+ * @brief Je Sprache: ein Index Code -> Text und die Texte selbst.
+ * Bekannte Texte stehen nur einmal in payload, unbekannte Codes haben je einen eigenen Eintrag.
+ */
+struct TextTable {
+    uint8_t index[256];
+    char payload[256][PAYLOAD_SIZE];
+};
+
+constexpr bool equals(const char *a, const char *b) {
+    while (*a && *a == *b) { a++; b++; }
+    return *a == *b;
+}
+
+// Kopiert höchstens DPT16_LENGTH Zeichen ab pos
+constexpr uint8_t append(char *dest, uint8_t pos, const char *src) {
+    while (*src && pos < DPT16_LENGTH) dest[pos++] = *src++;
+    dest[pos] = '\0';
+    return pos;
+}
+
+constexpr uint8_t length(const char *s) {
+    uint8_t len = 0;
+    while (s[len]) len++;
+    return len;
+}
+
+// "Unbekannt (NN)"; passt es nicht in 14 Zeichen, entfällt das Leerzeichen
+constexpr void renderUnknown(char *dest, const char *prefix, uint8_t code) {
+    char number[6] = {'(', 0, 0, 0, 0, 0};
+    uint8_t pos = 1;
+    if (code >= 100) number[pos++] = '0' + code / 100;
+    if (code >= 10)  number[pos++] = '0' + (code / 10) % 10;
+    number[pos++] = '0' + code % 10;
+    number[pos++] = ')';
+
+    uint8_t len = append(dest, 0, prefix);
+    if (len + 1 + pos <= DPT16_LENGTH) len = append(dest, len, " ");
+    append(dest, len, number);
+}
+
+constexpr TextTable buildTable(uint8_t language) {
+    TextTable table{};
+    uint8_t slots = 0;
+    for (uint16_t code = 0; code < 256; code++) {
+        const char *text = nullptr;
+        for (const KnownState &state : KNOWN_STATES)
+            if (state.code == code) text = state.text[language];
+
+        if (text == nullptr) {
+            renderUnknown(table.payload[slots], UNKNOWN_PREFIX[language], code);
+            table.index[code] = slots++;
+            continue;
+        }
+
+        // Gleichen Text wiederverwenden
+        uint8_t slot = slots;
+        for (uint8_t i = 0; i < slots; i++)
+            if (equals(table.payload[i], text)) slot = i;
+        if (slot == slots) append(table.payload[slots++], 0, text);
+        table.index[code] = slot;
+    }
+    return table;
+}
+
+static constexpr TextTable TABLES[LanguageCount] = {buildTable(German), buildTable(English)};
+
+static_assert([]() {
+    for (const KnownState &state : KNOWN_STATES)
+        for (const char *text : state.text)
+            if (length(text) > DPT16_LENGTH) return false;
+    for (const char *text : INITIAL)
+        if (length(text) > DPT16_LENGTH) return false;
+    return true;
+}(), "Statustext länger als 14 Zeichen wird auf dem Bus abgeschnitten");
+
+static const TextTable *_table = &TABLES[German];
+static uint8_t _language = German;
+
+void setLanguage(uint8_t language) {
+    _language = (language < LanguageCount) ? language : German;
+    _table = &TABLES[_language];
+}
+
+const char *get(uint8_t code) {
+    return _table->payload[_table->index[code]];
+}
+
+const char *initial() {
+    return INITIAL[_language];
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Klartexte zum Ofenstatus (oven_state_num) für das DPT-16-KO.
+ *
+ * Alle Texte liegen zur Compile-Zeit fertig gekürzt (max. 14 Zeichen) im Flash.
+ * Gleiche Texte haben denselben Pointer, ein Vergleich zweier Texte ist daher
+ * ein Pointer-Vergleich.
+ */
+namespace OvenStateText {
+    // Nutzlast eines DPT-16-Telegramms
+    static constexpr uint8_t DPT16_LENGTH = 14;
+
+    enum Language : uint8_t {
+        German,
+        English,
+        LanguageCount
+    };
+
+    /**
+     * @brief Wählt die Sprache (ETS-Parameter), vor dem ersten Frame aufrufen.
+     */
+    void setLanguage(uint8_t language);
+
+    /**
+     * @brief Text zum Statuscode, unbekannte Codes als "Unbekannt (NN)".
+     */
+    const char *get(uint8_t code);
+
+    /**
+     * @brief Text vor dem ersten empfangenen Status.
+     */
+    const char *initial();
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "OpenKNX.h"
+#include "DataModel.h"
+#include "KnxSendScheduler.h"
+#include "OvenStateText.h"
+
+/**
+ * @brief Felder mit Hysterese-Parameter. Nur für diese wird der zuletzt
+ * gesendete Wert gehalten, alle anderen senden bei jedem Dirty-Bit.
+ */
+namespace HysteresisSlot {
+    enum : uint8_t {
+        CombustionTemp,
+        MaxCombustionTemp,
+        SmolderingTemp,
+        AirFlapAct,
+        AirFlapTarget,
+        Trend,
+        Count,
+        None = 0xFF
+    };
+}
+
+template<auto Member>
+inline constexpr uint8_t hysteresisSlot = HysteresisSlot::None;
+
+template<> inline constexpr uint8_t hysteresisSlot<&Data::combustion_temp>     = HysteresisSlot::CombustionTemp;
+template<> inline constexpr uint8_t hysteresisSlot<&Data::max_combustion_temp> = HysteresisSlot::MaxCombustionTemp;
+template<> inline constexpr uint8_t hysteresisSlot<&Data::smoldering_temp>     = HysteresisSlot::SmolderingTemp;
+template<> inline constexpr uint8_t hysteresisSlot<&Data::air_flap_act>        = HysteresisSlot::AirFlapAct;
+template<> inline constexpr uint8_t hysteresisSlot<&Data::air_flap_target>     = HysteresisSlot::AirFlapTarget;
+template<> inline constexpr uint8_t hysteresisSlot<&Data::trend>               = HysteresisSlot::Trend;
+
+/**
+ * @brief Zuletzt gesendeter Wert und Sendeparameter (ETS) je Hysterese-Feld.
+ *
+ * Im adaptiven Modus wird nicht gegen den zuletzt gesendeten Wert verglichen,
+ * sondern gegen die lineare Fortschreibung der letzten beiden Telegramme, also
+ * den Wert, den ein Empfänger selbst vorhersagen würde. Gleichmäßige Rampen
+ * beim Anheizen erzeugen so nur bei Knicken ein Telegramm.
+ */
+struct HysteresisState {
+    int16_t lastSent[HysteresisSlot::Count] = {};
+    float amount[HysteresisSlot::Count] = {};       // 0 = jede Änderung
+    float slope[HysteresisSlot::Count] = {};        // Steigung zwischen den letzten beiden Sendungen (pro s)
+    uint32_t lastSentAt[HysteresisSlot::Count] = {};  // millis
+    uint8_t minInterval[HysteresisSlot::Count] = {};  // s, 0 = ohne Mindestabstand
+    uint8_t maxInterval[HysteresisSlot::Count] = {};  // s, 0 = ohne Höchstabstand
+    uint8_t adaptive = 0;                           // Bit je Slot: Vergleich mit der Vorhersage
+    uint8_t sent = 0;                               // Bit je Slot: lastSent stammt aus einem Telegramm
+
+    bool isAdaptive(uint8_t slot) const { return adaptive & (1 << slot); }
+
+    /**
+     * @brief Wert, den der Empfänger zum Zeitpunkt now annimmt.
+     */
+    float predicted(uint8_t slot, uint32_t now) const {
+        if (!isAdaptive(slot)) return lastSent[slot];
+        return lastSent[slot] + slope[slot] * (float)(now - lastSentAt[slot]) / 1000;
+    }
+
+    /**
+     * @brief Übernimmt einen gesendeten Wert; die Steigung erst ab dem zweiten Telegramm.
+     */
+    void commit(uint8_t slot, int16_t value, uint32_t now) {
+        const uint8_t bit = 1 << slot;
+        const uint32_t elapsed = now - lastSentAt[slot];
+        slope[slot] = ((sent & bit) && elapsed) ? (value - lastSent[slot]) * 1000.0f / elapsed : 0;
+        lastSent[slot] = value;
+        lastSentAt[slot] = now;
+        sent |= bit;
+    }
+
+    /**
+     * @brief Abweichung, ab der gesendet wird. Ohne Hysterese jede Änderung
+     * (die Werte sind ganzzahlig, die Vorhersage wird beim Empfänger gerundet).
+     */
+    float threshold(uint8_t slot) const { return amount[slot] > 0 ? amount[slot] : 0.5f; }
+
+    /**
+     * @brief Wartezeit in ms, bis die Vorhersage bei unverändertem Messwert die
+     * Schwelle erreicht (0 = nie, z.B. ohne Steigung). Max. 255 s, danach wird neu bewertet.
+     */
+    uint32_t driftTime(uint8_t slot, float deviation) const {
+        if (!isAdaptive(slot) || slope[slot] == 0) return 0;
+        const float rate = slope[slot] < 0 ? -slope[slot] : slope[slot];
+        const float ms = (threshold(slot) - deviation) * 1000 / rate;
+        if (ms <= 0) return 1;
+        return ms < 255000 ? (uint32_t)ms + 1 : 255000;
+    }
+};
+
+/**
+ * @brief Einheitliche Sende-Logik "Änderung >= Hysterese ODER Zyklus abgelaufen".
+ *
+ * Wird je Feld instanziiert; die Tabelle in CANGatewayModule.cpp bindet sie an
+ * KO-Nummer und Parameter. Zyklus sowie Mindest- und Höchstabstand werden über
+ * DeadlineQueues im Modul geführt.
+ *
+ * @tparam Member  Feld in Data
+ * @tparam KoT     Typ, mit dem der Wert ins KO geschrieben wird
+ * @tparam DptMain Hauptnummer des DPT
+ * @tparam DptSub  Subnummer des DPT
+ */
+template<auto Member, typename KoT, uint16_t DptMain, uint16_t DptSub>
+struct SendPolicy {
+    static constexpr uint8_t field = fieldIndex<Member>;
+    static constexpr uint8_t slot = hysteresisSlot<Member>;
+    static_assert(slot == HysteresisSlot::None || sizeof((((Data *)nullptr)->*Member).value) <= sizeof(int16_t),
+                  "Hysterese-Werte werden als int16_t gehalten");
+
+    /**
+     * @brief Betrag der Abweichung vom Wert, den der Empfänger annimmt
+     * (zuletzt gesendet bzw. vorhergesagt). Nur für Felder mit Hysterese-Slot.
+     */
+    static float deviation(const Data &current, const HysteresisState &state, uint32_t now) {
+        if constexpr (slot == HysteresisSlot::None) {
+            return 0;
+        } else {
+            float diff = (float)(current.*Member).value - state.predicted(slot, now);
+            return diff < 0 ? -diff : diff;
+        }
+    }
+
+    static void commit(const Data &current, HysteresisState &state, uint32_t now) {
+        if constexpr (slot != HysteresisSlot::None)
+            state.commit(slot, (int16_t)(current.*Member).value, now);
+    }
+
+    // send = false: nur den KO-Wert setzen (für Lese-Anfragen), kein Telegramm
+    static void write(uint16_t ko, const Data &current, bool send) {
+        GroupObject &object = knx.getGroupObject(ko);
+        if (send)
+            object.value((KoT)(current.*Member).value, Dpt(DptMain, DptSub));
+        else
+            object.valueNoSend((KoT)(current.*Member).value, Dpt(DptMain, DptSub));
+    }
+};
+
+/**
+ * @brief Status-Text (DPT 16): kein Field, Änderungen kommen über das Dirty-Bit.
+ * Das Dirty-Bit wird nur bei einem anderen (internierten) Text gesetzt.
+ */
+struct TextSendPolicy {
+    static constexpr uint8_t field = DataField::OvenStateText;
+
+    static constexpr uint8_t slot = HysteresisSlot::None;
+
+    static float deviation(const Data &, const HysteresisState &, uint32_t) { return 0; }
+    static void commit(const Data &, HysteresisState &, uint32_t) {}
+
+    static void write(uint16_t ko, const Data &current, bool send) {
+        const char *text = current.oven_state_text ? current.oven_state_text : OvenStateText::initial();
+        GroupObject &object = knx.getGroupObject(ko);
+        if (send)
+            object.value(text, Dpt(16, 0));
+        else
+            object.valueNoSend(text, Dpt(16, 0));
+    }
+};
+
+/**
+ * @brief Eintrag der Sende-Tabelle (Feld, Hysterese-Slot, KO, Priorität und die Funktionen der Policy).
+ */
+struct SendEntry {
+    uint8_t field;
+    uint8_t slot;
+    uint16_t ko;
+    SendPriority priority;
+    float (*deviation)(const Data &current, const HysteresisState &state, uint32_t now);
+    void (*commit)(const Data &current, HysteresisState &state, uint32_t now);
+    void (*write)(uint16_t ko, const Data &current, bool send);
+};
+
+template<typename Policy>
+constexpr SendEntry makeSendEntry(uint16_t ko, SendPriority priority) {
+    return { Policy::field, Policy::slot, ko, priority, &Policy::deviation, &Policy::commit, &Policy::write };
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Lock-freier Ringpuffer für genau einen Erzeuger und einen Verbraucher.
+ *
+ * Erzeuger und Verbraucher dürfen in unterschiedlichen Kontexten laufen
+ * (ISR / loop1 bzw. Core 1 / Core 0). Es werden nur atomare Lade- und
+ * Speicheroperationen benötigt, die auch der Cortex-M0+ ohne Sperren kann.
+ *
+ * @tparam T    Elementtyp (trivial kopierbar)
+ * @tparam Size Anzahl Plätze, muss eine Zweierpotenz sein
+ */
+template<typename T, uint16_t Size>
+class SpscRing {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "Size muss eine Zweierpotenz sein");
+
+public:
+    /**
+     * @brief Legt ein Element ab (nur Erzeuger).
+     * @return false, wenn der Puffer voll ist. Das Element wird verworfen und gezählt.
+     */
+    bool push(const T &item) {
+        const uint16_t head = _head.load(std::memory_order_relaxed);
+        const uint16_t tail = _tail.load(std::memory_order_acquire);
+        const uint16_t used = (uint16_t)(head - tail);
+        if (used >= Size) {
+            _overflows++;
+            return false;
+        }
+        _buffer[head & (Size - 1)] = item;
+        _head.store((uint16_t)(head + 1), std::memory_order_release);
+        if (used + 1 > _highWater) _highWater = used + 1;
+        return true;
+    }
+
+    /**
+     * @brief Entnimmt das älteste Element (nur Verbraucher).
+     * @return false, wenn der Puffer leer ist.
+     */
+    bool pop(T &item) {
+        const uint16_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        item = _buffer[tail & (Size - 1)];
+        _tail.store((uint16_t)(tail + 1), std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire);
+    }
+
+    uint16_t count() const {
+        return (uint16_t)(_head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire));
+    }
+
+    uint16_t freeSpace() const { return Size - count(); }
+
+    static constexpr uint16_t capacity() { return Size; }
+
+    // Diagnose: werden nur vom Erzeuger geschrieben
+    uint32_t overflows() const { return _overflows; }
+    uint16_t highWater() const { return _highWater; }
+
+private:
+    T _buffer[Size];
+    std::atomic<uint16_t> _head{0};
+    std::atomic<uint16_t> _tail{0};
+    volatile uint32_t _overflows = 0;
+    volatile uint16_t _highWater = 0;
+};
@@ -0,0 +1,100 @@
+#include "UnknownByteAnalyzer.h"
+#include <math.h>
+#include <string.h>
+
+struct UnknownField {
+    uint8_t field;
+    const char *name;
+    uint16_t (*value)(const Data &data);
+};
+
+static const UnknownField UNKNOWN_FIELDS[UnknownByteAnalyzer::UNKNOWN_COUNT] = {
+    {DataField::Byte281_5,      "281[5]",   [](const Data &d) -> uint16_t { return d.byte281_5.value; }},
+    {DataField::Byte281_6,      "281[6]",   [](const Data &d) -> uint16_t { return d.byte281_6.value; }},
+    {DataField::UnknownCounter, "283.2[1]", [](const Data &d) -> uint16_t { return d.unknown_counter.value; }},
+    {DataField::Byte283_1_6,    "283.1[6]", [](const Data &d) -> uint16_t { return d.byte283_1_6.value; }},
+    {DataField::Byte283_3_1,    "283.3[1]", [](const Data &d) -> uint16_t { return d.byte283_3_1.value; }},
+    {DataField::Byte283_3_2,    "283.3[2]", [](const Data &d) -> uint16_t { return d.byte283_3_2.value; }},
+    {DataField::Byte283_3_3,    "283.3[3]", [](const Data &d) -> uint16_t { return d.byte283_3_3.value; }},
+    {DataField::Byte283_3_4,    "283.3[4]", [](const Data &d) -> uint16_t { return d.byte283_3_4.value; }},
+    {DataField::Byte283_3_5,    "283.3[5]", [](const Data &d) -> uint16_t { return d.byte283_3_5.value; }},
+    {DataField::Byte283_3_6,    "283.3[6]", [](const Data &d) -> uint16_t { return d.byte283_3_6.value; }},
+};
+
+static const char *const REFERENCE_NAMES[UnknownByteAnalyzer::ReferenceCount] = {"Temp", "Klappe", "Status"};
+
+void UnknownByteAnalyzer::reset() {
+    memset(_stats, 0, sizeof(_stats));
+    _transitions = 0;
+    _lastTransition = 0;
+}
+
+void UnknownByteAnalyzer::update(const Data &data, uint32_t present, uint32_t changed, uint32_t millis) {
+    if (changed & DataField::bit(DataField::OvenStateNum)) {
+        _transitions++;
+        _lastTransition = millis;
+    }
+    const bool nearTransition = _transitions > 0 && (millis - _lastTransition) <= TRANSITION_WINDOW_MS;
+
+    const double reference[ReferenceCount] = {
+        (double)data.combustion_temp.value,
+        (double)data.air_flap_act.value,
+        (double)data.oven_state_num.value,
+    };
+
+    for (uint8_t i = 0; i < UNKNOWN_COUNT; i++) {
+        const UnknownField &field = UNKNOWN_FIELDS[i];
+        if (!(present & DataField::bit(field.field))) continue;
+
+        ByteStats &s = _stats[i];
+        const uint16_t value = field.value(data);
+        s.samples++;
+        s.histogram[value & 0xFF]++;
+        if (changed & DataField::bit(field.field)) {
+            s.changes++;
+            if (nearTransition) s.transitionChanges++;
+        }
+
+        // Welford: Mittelwerte, Varianzen und Ko-Momente in einem Durchlauf
+        const double n = s.samples;
+        const double dx = value - s.mean;
+        s.mean += dx / n;
+        s.m2 += dx * (value - s.mean);
+        for (uint8_t r = 0; r < ReferenceCount; r++) {
+            const double dy = reference[r] - s.refMean[r];
+            s.refMean[r] += dy / n;
+            s.refM2[r] += dy * (reference[r] - s.refMean[r]);
+            s.coMoment[r] += dx * (reference[r] - s.refMean[r]);
+        }
+    }
+}
+
+const char *UnknownByteAnalyzer::name(uint8_t index) {
+    return UNKNOWN_FIELDS[index].name;
+}
+
+const char *UnknownByteAnalyzer::referenceName(uint8_t reference) {
+    return REFERENCE_NAMES[reference];
+}
+
+int8_t UnknownByteAnalyzer::correlation(uint8_t index, uint8_t reference) const {
+    const ByteStats &s = _stats[index];
+    const double denominator = sqrt(s.m2 * s.refM2[reference]);
+    if (denominator <= 0) return 0;
+    return (int8_t)lround(100.0 * s.coMoment[reference] / denominator);
+}
+
+uint16_t UnknownByteAnalyzer::distinctValues(uint8_t index) const {
+    uint16_t distinct = 0;
+    for (uint32_t count : _stats[index].histogram)
+        distinct += (count > 0);
+    return distinct;
+}
+
+uint8_t UnknownByteAnalyzer::mostFrequent(uint8_t index) const {
+    const uint32_t *histogram = _stats[index].histogram;
+    uint8_t best = 0;
+    for (uint16_t v = 1; v < 256; v++)
+        if (histogram[v] > histogram[best]) best = v;
+    return best;
+}
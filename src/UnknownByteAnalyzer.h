@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdint.h>
+#include "DataModel.h"
+
+// Analyse einkompilieren (ca. 11 KB RAM)
+#ifndef LEDA_ANALYZER_ENABLED
+    #define LEDA_ANALYZER_ENABLED 0
+#endif
+
+/**
+ * @brief Streaming-Auswertung der noch unbekannten Bytes in Data.
+ *
+ * Je unbekanntem Wert: Änderungshäufigkeit, Histogramm, Korrelation mit
+ * Verbrennungstemperatur, Luftklappe und Ofenstatus sowie Änderungen kurz
+ * nach einem Statuswechsel. Ein Durchlauf, fester Speicher unabhängig von
+ * der Länge des Traces; Mittelwerte und Kovarianzen nach Welford, damit
+ * auch Milliarden Samples numerisch stabil bleiben.
+ *
+ * Hängt nur vom Datenmodell ab und läuft auf dem Gerät (live oder über die
+ * Aufzeichnung) ebenso wie im Host-Tool tools/LedaCaptureAnalyze.cpp.
+ */
+class UnknownByteAnalyzer {
+public:
+    enum Reference : uint8_t {
+        RefCombustionTemp,
+        RefAirFlapAct,
+        RefOvenStateNum,
+        ReferenceCount
+    };
+
+    static constexpr uint8_t UNKNOWN_COUNT = 10;
+
+    // Änderungen bis zu diesem Abstand nach einem Statuswechsel zählen als gemeinsam
+    static constexpr uint32_t TRANSITION_WINDOW_MS = 2000;
+
+    struct ByteStats {
+        uint32_t samples;               // Frames, die den Wert enthielten
+        uint32_t changes;               // davon mit geändertem Wert
+        uint32_t transitionChanges;     // davon kurz nach einem Statuswechsel
+        uint32_t histogram[256];        // Werte (bei 16 Bit: Low-Byte)
+        double mean;
+        double m2;
+        double refMean[ReferenceCount];
+        double refM2[ReferenceCount];
+        double coMoment[ReferenceCount];
+    };
+
+    void reset();
+
+    /**
+     * @brief Verarbeitet einen dekodierten Frame.
+     * @param present DataField-Bits der im Frame enthaltenen Felder
+     * @param changed DataField-Bits der durch den Frame geänderten Felder
+     */
+    void update(const Data &data, uint32_t present, uint32_t changed, uint32_t millis);
+
+    static const char *name(uint8_t index);
+    static const char *referenceName(uint8_t reference);
+
+    const ByteStats &stats(uint8_t index) const { return _stats[index]; }
+    uint32_t transitions() const { return _transitions; }
+
+    // Pearson-Korrelation in Prozent (-100..100), 0 ohne Varianz
+    int8_t correlation(uint8_t index, uint8_t reference) const;
+    uint16_t distinctValues(uint8_t index) const;
+    uint8_t mostFrequent(uint8_t index) const;
+
+private:
+    ByteStats _stats[UNKNOWN_COUNT];
+    uint32_t _transitions = 0;
+    uint32_t _lastTransition = 0;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stdint.h>
+#include <float.h>
+
+/**
+ * @brief Ergebnis eines abgeschlossenen Statistik-Fensters.
+ */
+struct WindowResult {
+    float min;
+    float max;
+    float mean;             // zeitgewichtet
+    float slopePerMinute;   // zeitgewichtete lineare Regression
+    uint32_t secondsAbove;  // Zeit über der Schwelle
+    bool valid;             // Fenster enthielt einen Wert
+};
+
+/**
+ * @brief Statistik eines Signals über ein festes (tumbling) Zeitfenster.
+ *
+ * Jedes Sample kostet konstante Zeit, der Speicher ist unabhängig von der
+ * Anzahl Samples. Ein Wert gilt bis zum nächsten Sample (Senden bei Änderung),
+ * das Signal ist also stückweise konstant. Mittelwert, Zeit über Schwelle und
+ * Steigung werden über die Haltedauer gewichtet, schnelle Frame-Folgen
+ * verschieben die Kennwerte daher nicht.
+ *
+ * Gerechnet wird in float statt double (Software-Arithmetik auf dem RP2040).
+ * Mittelwerte und Ko-Momente werden dazu inkrementell um den laufenden
+ * Mittelwert geführt (West), große Summen löschen sich so nicht aus.
+ */
+class WindowStats {
+public:
+    /**
+     * @brief Schwelle für secondsAbove (Standard: aus).
+     */
+    void setThreshold(float threshold) { _threshold = threshold; }
+
+    /**
+     * @brief Beginnt ein neues Fenster; ein vorhandener Wert gilt weiter.
+     */
+    void begin(uint32_t now) {
+        _start = now;
+        _last = now;
+        _msAbove = 0;
+        _weight = _meanT = _meanY = _ctt = _cty = 0;
+        if (_hasValue)
+            _min = _max = _value;
+    }
+
+    void add(float value, uint32_t now) {
+        accumulate(now);
+        if (!_hasValue) {
+            _min = _max = value;
+        } else {
+            if (value < _min) _min = value;
+            if (value > _max) _max = value;
+        }
+        _value = value;
+        _hasValue = true;
+    }
+
+    /**
+     * @brief Schließt das Fenster ab und beginnt das nächste.
+     */
+    WindowResult close(uint32_t now) {
+        accumulate(now);
+        WindowResult result = {};
+        result.valid = _hasValue && _weight > 0;
+        if (result.valid) {
+            result.min = _min;
+            result.max = _max;
+            result.mean = _meanY;
+            result.secondsAbove = _msAbove / 1000;
+            result.slopePerMinute = (_ctt > 0) ? _cty / _ctt * 60.0f : 0;
+        }
+        begin(now);
+        return result;
+    }
+
+private:
+    float _threshold = FLT_MAX;
+    uint32_t _start = 0;
+    uint32_t _last = 0;
+    float _value = 0;
+    bool _hasValue = false;
+    float _min = 0;
+    float _max = 0;
+    uint32_t _msAbove = 0;
+    // Gewichtete Momente (t in Sekunden ab Fensterbeginn, Gewicht = Haltedauer in s)
+    float _weight = 0;
+    float _meanT = 0;
+    float _meanY = 0;
+    float _ctt = 0;             // Summe w * (t - meanT)^2, inkl. Streuung innerhalb der Haltedauer
+    float _cty = 0;             // Summe w * (t - meanT) * (y - meanY)
+
+    /**
+     * @brief Verbucht den bisherigen Wert für die Zeit seit dem letzten Sample.
+     * Ein Intervall zählt mit seiner Mitte; w^3/12 ist die Varianz der Zeit
+     * innerhalb des Intervalls, damit entspricht die Steigung der
+     * kontinuierlichen Regression über das stückweise konstante Signal.
+     */
+    void accumulate(uint32_t now) {
+        const uint32_t dt = now - _last;
+        const float t = ((_last - _start) + dt * 0.5f) / 1000.0f;
+        _last = now;
+        if (!_hasValue || dt == 0) return;
+        if (_value > _threshold) _msAbove += dt;
+
+        const float w = dt / 1000.0f;
+        _weight += w;
+        const float dT = t - _meanT;
+        const float dY = _value - _meanY;
+        const float share = w / _weight;
+        _meanT += dT * share;
+        _meanY += dY * share;
+        _ctt += w * dT * (t - _meanT) + w * w * w / 12.0f;
+        _cty += w * dT * (_value - _meanY);
+    }
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+// Minimale Prüfmakros für die Host-Tests: Fehler werden gemeldet und gezählt,
+// TEST_RESULT() liefert den Exit-Code für ctest.
+
+#include <stdio.h>
+#include <math.h>
+
+static int testFailures = 0;
+
+#define CHECK(cond)                                                                 \
+    do {                                                                            \
+        if (!(cond)) {                                                              \
+            printf("%s:%d: CHECK(%s) fehlgeschlagen\n", __FILE__, __LINE__, #cond); \
+            testFailures++;                                                         \
+        }                                                                           \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                              \
+    do {                                                                                            \
+        const long long _a = (long long)(a), _b = (long long)(b);                                   \
+        if (_a != _b) {                                                                             \
+            printf("%s:%d: %s == %s fehlgeschlagen (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+            testFailures++;                                                                         \
+        }                                                                                           \
+    } while (0)
+
+#define CHECK_NEAR(a, b, eps)                                                                       \
+    do {                                                                                            \
+        const double _a = (a), _b = (b);                                                            \
+        if (fabs(_a - _b) > (eps)) {                                                                \
+            printf("%s:%d: %s ~ %s fehlgeschlagen (%g != %g)\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+            testFailures++;                                                                         \
+        }                                                                                           \
+    } while (0)
+
+#define TEST_RESULT() (testFailures == 0 ? 0 : 1)
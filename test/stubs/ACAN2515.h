@@ -0,0 +1,26 @@
+#pragma once
+
+// Host-Build: nur der Frame-Typ des ACAN2515-Treibers (wie ACAN2515 2.1.5)
+
+#include <stdint.h>
+#include <string.h>
+
+class CANMessage {
+public:
+    uint32_t id = 0;
+    bool ext = false;
+    bool rtr = false;
+    uint8_t idx = 0;
+    uint8_t len = 0;
+    union {
+        uint64_t data64;
+        int64_t data_s64;
+        uint32_t data32[2];
+        int32_t data_s32[2];
+        float dataFloat[2];
+        uint16_t data16[4];
+        int16_t data_s16[4];
+        int8_t data_s8[8];
+        uint8_t data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    };
+};
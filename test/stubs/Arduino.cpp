@@ -0,0 +1,19 @@
+#include "Arduino.h"
+#include <stdarg.h>
+
+HostSerial Serial;
+HostRP2040 rp2040;
+
+static uint32_t _millis = 0;
+
+uint32_t millis() { return _millis; }
+uint32_t micros() { return _millis * 1000; }
+void hostSetMillis(uint32_t ms) { _millis = ms; }
+
+int HostSerial::printf(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    const int n = vprintf(format, args);
+    va_end(args);
+    return n;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+// Host-Build: Ersatz für den Arduino-Core, soweit die Quellen unter src/ ihn nutzen.
+// Die Zeit läuft nicht von selbst, Tests stellen sie mit hostSetMillis().
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+uint32_t millis();
+uint32_t micros();
+void hostSetMillis(uint32_t ms);
+
+#define F(x) x
+#define HEX 16
+
+/**
+ * @brief Serielle Schnittstelle, schreibt auf stdout.
+ */
+struct HostSerial {
+    int availableForWrite() { return 4096; }
+    size_t write(const uint8_t *buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+    int printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    void print(const char *text) { fputs(text, stdout); }
+    void println(const char *text) { puts(text); }
+};
+extern HostSerial Serial;
+
+/**
+ * @brief Takt-Abfragen für LedaProfile.
+ */
+struct HostRP2040 {
+    uint32_t getCycleCount() { return micros(); }
+    uint32_t f_cpu() { return 1000000; }
+};
+extern HostRP2040 rp2040;
@@ -0,0 +1,39 @@
+#include "CANInterface.h"
+#include "CanBusTelemetry.h"
+#include "HostCanInterface.h"
+#include "SpscRing.h"
+
+// Host-Build: kein MCP2515, Frames kommen über hostCanReceive() in denselben Ring
+// wie auf dem Gerät aus der ISR. Gesendet wird nichts, tryTransmit() zählt nur.
+
+static SpscRing<CANMessage, LEDA_CAN_RX_RING_SIZE> rxRing;
+static uint32_t rxOverflowCount = 0;
+static uint32_t rxBitCount = 0;
+static uint32_t txFrameCount = 0;
+
+bool hostCanReceive(const CANMessage &msg) {
+    rxBitCount += CanBusTelemetry::frameBits(msg);
+    if (rxRing.push(msg)) return true;
+    rxOverflowCount++;
+    return false;
+}
+
+bool CANInterface::begin(bool promiscuous, const uint16_t *ids, uint8_t idCount) { return true; }
+bool CANInterface::available() { return !rxRing.empty(); }
+void CANInterface::getNextMessage(CANMessage &msg) { rxRing.pop(msg); }
+
+bool CANInterface::tryTransmit(const CANMessage &msg) {
+    txFrameCount++;
+    return true;
+}
+
+uint32_t CANInterface::rxOverflows() { return rxOverflowCount; }
+uint16_t CANInterface::rxHighWater() { return 0; }
+uint16_t CANInterface::rxCapacity() { return LEDA_CAN_RX_RING_SIZE; }
+uint16_t CANInterface::rxDriverPeak() { return 0; }
+uint32_t CANInterface::txFrames() { return txFrameCount; }
+uint32_t CANInterface::txBusy() { return 0; }
+uint32_t CANInterface::busBits() { return rxBitCount; }
+uint32_t CANInterface::bitRate() { return 125000; }
+CanErrorState CANInterface::readErrorState() { return CanErrorState(); }
+void CANInterface::isr() {}
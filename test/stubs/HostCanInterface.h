@@ -0,0 +1,10 @@
+#pragma once
+
+// Host-Build: Einspeisung für den Ersatz von CANInterface (test/stubs/CANInterface.cpp).
+// Frames stehen danach über CANInterface::available()/getNextMessage() bereit,
+// wie sonst nach der ISR.
+
+#include <ACAN2515.h>
+
+// false, wenn der Empfangsring voll ist (zählt in CANInterface::rxOverflows())
+bool hostCanReceive(const CANMessage &msg);
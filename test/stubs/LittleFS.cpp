@@ -0,0 +1,38 @@
+#include "LittleFS.h"
+#include <string.h>
+
+HostLittleFS LittleFS;
+
+size_t File::read(uint8_t *buffer, size_t size) {
+    if (!_data || _position >= _data->size()) return 0;
+    if (size > _data->size() - _position) size = _data->size() - _position;
+    memcpy(buffer, _data->data() + _position, size);
+    _position += size;
+    return size;
+}
+
+size_t File::write(const uint8_t *buffer, size_t size) {
+    if (!_data) return 0;
+    if (_position + size > _data->size()) _data->resize(_position + size);
+    memcpy(_data->data() + _position, buffer, size);
+    _position += size;
+    return size;
+}
+
+// Wie lfs_file_seek: hinter das Dateiende erlaubt, write() füllt die Lücke mit Nullen
+bool File::seek(uint32_t position) {
+    if (!_data) return false;
+    _position = position;
+    return true;
+}
+
+File HostLittleFS::open(const char *path, const char *mode) {
+    auto it = _files.find(path);
+    if (mode[0] == 'w') {
+        auto data = std::make_shared<std::vector<uint8_t>>();
+        _files[path] = data;
+        return File(data);
+    }
+    if (it == _files.end()) return File();
+    return File(it->second);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+// Host-Build: LittleFS im RAM. Dateien bleiben bis hostFormat() erhalten,
+// damit Tests Speichern und Laden über einen "Neustart" prüfen können.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class File {
+public:
+    File() = default;
+    explicit File(std::shared_ptr<std::vector<uint8_t>> data) : _data(std::move(data)) {}
+
+    operator bool() const { return _data != nullptr; }
+
+    size_t read(uint8_t *buffer, size_t size);
+    size_t write(const uint8_t *buffer, size_t size);
+    bool seek(uint32_t position);
+    size_t position() const { return _position; }
+    size_t size() const { return _data ? _data->size() : 0; }
+    void flush() {}
+    void close() { _data.reset(); }
+
+private:
+    std::shared_ptr<std::vector<uint8_t>> _data;
+    size_t _position = 0;
+};
+
+class HostLittleFS {
+public:
+    bool begin() { return true; }
+    File open(const char *path, const char *mode);
+    bool exists(const char *path) const { return _files.count(path) != 0; }
+    bool mkdir(const char *) { return true; }
+    bool remove(const char *path) { return _files.erase(path) != 0; }
+
+    void hostFormat() { _files.clear(); }
+
+private:
+    std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> _files;
+};
+extern HostLittleFS LittleFS;
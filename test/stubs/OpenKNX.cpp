@@ -0,0 +1,45 @@
+#include "OpenKNX.h"
+#include <stdarg.h>
+
+HostKnx knx;
+OpenKNX::Common openknx;
+
+#define LEDA_HOST_DEFINE_PARAM(type, name, value) type Param_##name = value;
+#define LEDA_HOST_DEFINE_CHANNEL_PARAM(type, name, value) type Param_##name##_1 = value, Param_##name##_2 = value;
+LEDA_HOST_PARAMS(LEDA_HOST_DEFINE_PARAM)
+LEDA_HOST_CHANNEL_PARAMS(LEDA_HOST_DEFINE_CHANNEL_PARAM)
+
+GroupObject &HostKnx::getGroupObject(uint16_t asap) {
+    if (asap >= KO_COUNT) {
+        fprintf(stderr, "KO %u außerhalb von knxprod.h\n", asap);
+        abort();
+    }
+    return _objects[asap];
+}
+
+namespace OpenKNX {
+
+    void Console::printHelpLine(const char *command, const char *description) {
+        if (!openknx.logger.quiet)
+            printf("%-20s %s\n", command, description);
+    }
+
+    void Console::writeDiagenoseKo(const char *format, ...) {
+        if (openknx.logger.quiet) return;
+        va_list args;
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+        putchar('\n');
+    }
+
+    void Logger::log(const char *format, ...) {
+        if (quiet) return;
+        printf("%*s", indent * 2, "");
+        va_list args;
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+        putchar('\n');
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+// Host-Build: Ersatz für den OpenKNX-Stack, soweit CANGateway ihn nutzt.
+// KOs merken sich nur den letzten Wert und zählen die gesendeten Telegramme.
+
+#include "Arduino.h"
+#include "knxprod.h"
+#include <string>
+#include <type_traits>
+
+struct Dpt {
+    Dpt(uint16_t main, uint16_t sub) : mainGroup(main), subGroup(sub) {}
+    uint16_t mainGroup;
+    uint16_t subGroup;
+};
+
+class GroupObject {
+public:
+    // Telegramme aller KOs seit Start (value(), nicht valueNoSend())
+    static inline uint32_t sentTotal = 0;
+
+    template <typename T>
+    void value(T value, const Dpt &type) {
+        valueNoSend(value, type);
+        _sent++;
+        sentTotal++;
+    }
+
+    template <typename T>
+    void valueNoSend(T value, const Dpt &type) {
+        _dpt = type;
+        if constexpr (std::is_arithmetic_v<T>) {
+            _number = (double)value;
+            _text[0] = '\0';
+        } else {
+            strncpy(_text, value, sizeof(_text) - 1);
+            _text[sizeof(_text) - 1] = '\0';
+        }
+    }
+
+    double number() const { return _number; }
+    const char *text() const { return _text; }
+    const Dpt &dpt() const { return _dpt; }
+    uint32_t sent() const { return _sent; }
+
+private:
+    Dpt _dpt{0, 0};
+    double _number = 0;
+    char _text[15] = "";    // DPT 16.000: 14 Zeichen
+    uint32_t _sent = 0;
+};
+
+class HostKnx {
+public:
+    static constexpr uint16_t KO_COUNT = 256;
+
+    GroupObject &getGroupObject(uint16_t asap);
+    uint16_t individualAddress() { return address; }
+
+    uint16_t address = 0x1101;
+
+private:
+    GroupObject _objects[KO_COUNT];
+};
+extern HostKnx knx;
+
+namespace OpenKNX {
+
+    class Module {
+    public:
+        virtual ~Module() = default;
+        virtual const std::string name() = 0;
+        virtual const std::string version() = 0;
+        virtual void setup() {}
+        virtual void loop() {}
+        virtual void setup1() {}
+        virtual void loop1() {}
+        virtual void processBeforeRestart() {}
+        virtual bool processCommand(const std::string cmd, bool diagnoseKo) { return false; }
+        virtual void showHelp() {}
+    };
+
+    class Console {
+    public:
+        void printHelpLine(const char *command, const char *description);
+        void writeDiagenoseKo(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    };
+
+    /**
+     * @brief Ausgabe von logInfoP/logErrorP auf stdout, für Messungen abschaltbar.
+     */
+    class Logger {
+    public:
+        void log(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+        bool quiet = false;
+        uint8_t indent = 0;
+    };
+
+    class Common {
+    public:
+        Console console;
+        Logger logger;
+    };
+}
+extern OpenKNX::Common openknx;
+
+#define logInfoP(...)   openknx.logger.log(__VA_ARGS__)
+#define logErrorP(...)  openknx.logger.log(__VA_ARGS__)
+#define logIndentUp()   openknx.logger.indent++
+#define logIndentDown() openknx.logger.indent--
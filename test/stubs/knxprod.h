@@ -0,0 +1,73 @@
+#pragma once
+
+// Host-Build: Ersatz für das von OpenKNXproducer erzeugte knxprod.h.
+// Die ETS-Parameter sind Variablen mit den Vorgaben aus LedaGateway.*.xml,
+// Werkzeuge können sie vor CANGateway::setup() umstellen.
+
+#include <stdint.h>
+
+#define LEDA_KoOffset         10
+#define LEDA_KoBlockSize      40
+#define LEDA_KoCanBusLoad      1
+#define LEDA_KoCanBusState     2
+#define LEDA_KoCanRxOverflows  3
+
+// Allgemeine Parameter: Typ, Name, Vorgabe
+#define LEDA_HOST_PARAMS(X)           \
+    X(uint8_t, CanPromiscuous, 0)     \
+    X(uint8_t, SendRate, 10)          \
+    X(uint8_t, SendBurst, 5)          \
+    X(uint8_t, StartupDelay, 5)       \
+    X(uint8_t, StateTextLanguage, 0)  \
+    X(uint8_t, ChannelCount, 1)
+
+// Kanal-Parameter (_1, _2): Typ, Name, Vorgabe
+#define LEDA_HOST_CHANNEL_PARAMS(X)         \
+    X(uint8_t, CombTempSendChg, 0)          \
+    X(float, CombTempAmount, 0.5f)          \
+    X(uint8_t, CombTempCycle, 5)            \
+    X(uint8_t, CombTempSendMode, 0)         \
+    X(uint8_t, CombTempMinInterval, 0)      \
+    X(uint8_t, CombTempMaxInterval, 0)      \
+    X(uint8_t, MaxCombTempSendChg, 0)       \
+    X(float, MaxCombTempAmount, 1.0f)       \
+    X(uint8_t, MaxCombTempCycle, 5)         \
+    X(uint8_t, MaxCombTempSendMode, 0)      \
+    X(uint8_t, MaxCombTempMinInterval, 0)   \
+    X(uint8_t, MaxCombTempMaxInterval, 0)   \
+    X(uint8_t, SmoldTempSendChg, 0)         \
+    X(float, SmoldTempAmount, 0.5f)         \
+    X(uint8_t, SmoldTempCycle, 5)           \
+    X(uint8_t, SmoldTempSendMode, 0)        \
+    X(uint8_t, SmoldTempMinInterval, 0)     \
+    X(uint8_t, SmoldTempMaxInterval, 0)     \
+    X(uint8_t, AirActSendChg, 0)            \
+    X(uint8_t, AirActAmount, 5)             \
+    X(uint8_t, AirActCycle, 5)              \
+    X(uint8_t, AirActSendMode, 0)           \
+    X(uint8_t, AirActMinInterval, 0)        \
+    X(uint8_t, AirActMaxInterval, 0)        \
+    X(uint8_t, AirTrgSendChg, 0)            \
+    X(uint8_t, AirTrgAmount, 5)             \
+    X(uint8_t, AirTrgCycle, 5)              \
+    X(uint8_t, AirTrgSendMode, 0)           \
+    X(uint8_t, AirTrgMinInterval, 0)        \
+    X(uint8_t, AirTrgMaxInterval, 0)        \
+    X(uint8_t, HeartbeatCycle, 1)           \
+    X(uint8_t, StateNumCycle, 5)            \
+    X(uint8_t, StateTxtCycle, 5)            \
+    X(uint8_t, TrendCycle, 5)               \
+    X(uint8_t, TrendAmount, 1)              \
+    X(uint8_t, HeatedCycle, 10)             \
+    X(uint8_t, Timeout281, 30)              \
+    X(uint8_t, Timeout283, 60)              \
+    X(uint8_t, StatsWindow, 0)              \
+    X(uint16_t, TempAboveThreshold, 600)    \
+    X(uint16_t, CanIdOffset, 0)
+
+#define LEDA_HOST_DECLARE_PARAM(type, name, value) extern type Param_##name;
+#define LEDA_HOST_DECLARE_CHANNEL_PARAM(type, name, value) extern type Param_##name##_1, Param_##name##_2;
+LEDA_HOST_PARAMS(LEDA_HOST_DECLARE_PARAM)
+LEDA_HOST_CHANNEL_PARAMS(LEDA_HOST_DECLARE_CHANNEL_PARAM)
+#undef LEDA_HOST_DECLARE_PARAM
+#undef LEDA_HOST_DECLARE_CHANNEL_PARAM
@@ -0,0 +1,101 @@
+#include "TestCheck.h"
+#include "BurnSession.h"
+#include <LittleFS.h>
+
+static void setState(Data &data, uint8_t state) {
+    data.set<&Data::oven_state_num>(state);
+    data.valid |= DataField::bit(DataField::OvenStateNum);
+}
+
+static uint32_t feed(BurnSessionTracker &tracker, Data &data, uint8_t state, uint32_t now) {
+    data.dirty = 0;
+    setState(data, state);
+    return tracker.update(data, data.dirty, now);
+}
+
+static void session() {
+    LittleFS.hostFormat();
+    BurnSessionTracker tracker;
+    CHECK(!tracker.load(0));        // Noch keine Datei
+    Data data = DEFAULT_VALUES;
+
+    // Erster Status heizt bereits: keine Sitzung mit falschem Beginn
+    CHECK_EQ(feed(tracker, data, 4, 0), BurnSessionTracker::None);
+    CHECK(!tracker.active());
+    CHECK_EQ(feed(tracker, data, 0, 1000), BurnSessionTracker::None);
+
+    CHECK_EQ(feed(tracker, data, 1, 10000), BurnSessionTracker::Started);
+    data.dirty = 0;
+    data.set<&Data::combustion_temp>(650);
+    tracker.update(data, data.dirty, 20000);
+    feed(tracker, data, 4, 70000);
+    feed(tracker, data, 8, 130000);
+    feed(tracker, data, 4, 190000);
+    CHECK_EQ(feed(tracker, data, 97, 250000), BurnSessionTracker::Ended);
+
+    const BurnSession &last = tracker.last();
+    CHECK_EQ(last.number, 1);
+    CHECK_EQ(last.duration, 240);
+    CHECK_EQ(last.peakTemp, 650);
+    CHECK_EQ(last.refuels, 1);
+    CHECK_EQ(last.endState, 97);
+    CHECK_EQ(last.stateSeconds[0], 60);
+    CHECK_EQ(last.stateSeconds[3], 120);
+    CHECK_EQ(last.stateSeconds[4], 60);
+    CHECK_EQ(tracker.totals().errorSessions, 1);
+
+    // Ein Schreibvorgang je Abbrand
+    CHECK(tracker.persist());
+    CHECK(!tracker.persist());
+
+    BurnSessionTracker reloaded;
+    CHECK(reloaded.load(0));
+    CHECK_EQ(reloaded.totals().sessions, 1);
+    CHECK_EQ(reloaded.totals().burnSeconds, 240);
+    CHECK_EQ(reloaded.last().peakTemp, 650);
+    BurnSession stored = {};
+    CHECK(reloaded.history(0, stored));
+    CHECK_EQ(stored.number, 1);
+    CHECK(!reloaded.history(1, stored));
+}
+
+static void resumeAfterReboot() {
+    LittleFS.hostFormat();
+    BurnSessionTracker tracker;
+    tracker.load(1);
+    Data data = DEFAULT_VALUES;
+    feed(tracker, data, 0, 0);
+    feed(tracker, data, 1, 1000);
+    feed(tracker, data, 4, 61000);
+    const ActiveSession saved = tracker.snapshot(121000);
+    CHECK_EQ(saved.session.number, 1);
+    CHECK_EQ(saved.elapsedMs, 120000);
+
+    // Neustart: 30 s ohne Strom zählen nicht, der Ofen heizt weiter
+    BurnSessionTracker restarted;
+    restarted.load(1);
+    CHECK(!restarted.resume(saved, 0, 30000));
+    CHECK(restarted.resume(saved, 4, 30000));
+    CHECK(restarted.active());
+    Data after = DEFAULT_VALUES;
+    setState(after, 4);
+    restarted.update(after, 0, 30000);
+    after.dirty = 0;
+    setState(after, 0);
+    CHECK_EQ(restarted.update(after, after.dirty, 90000), BurnSessionTracker::Ended);
+    CHECK_EQ(restarted.last().duration, 180);
+    CHECK_EQ(restarted.last().stateSeconds[0], 60);
+    CHECK_EQ(restarted.last().stateSeconds[3], 60);
+    CHECK(restarted.persist());
+
+    // Abgeschlossene Sitzung wird nicht ein zweites Mal fortgesetzt
+    BurnSessionTracker again;
+    CHECK(again.load(1));
+    CHECK(!again.resume(saved, 4, 0));
+}
+
+int main() {
+    session();
+    resumeAfterReboot();
+    return TEST_RESULT();
+}
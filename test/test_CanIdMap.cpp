@@ -0,0 +1,31 @@
+#include "TestCheck.h"
+#include "CanIdMap.h"
+
+int main() {
+    CanIdMap map;
+    CHECK_EQ(map.lookup(0x281), CanIdMap::NONE);
+
+    // Benachbarte IDs teilen sich ein Byte
+    CHECK(map.assign(0x280, 3));
+    CHECK(map.assign(0x281, 0));
+    CHECK(map.assign(0x283, 1));
+    CHECK_EQ(map.lookup(0x280), 3);
+    CHECK_EQ(map.lookup(0x281), 0);
+    CHECK_EQ(map.lookup(0x282), CanIdMap::NONE);
+    CHECK_EQ(map.lookup(0x283), 1);
+
+    // Doppelt vergebene, ungültige IDs und Kanäle
+    CHECK(!map.assign(0x281, 2));
+    CHECK_EQ(map.lookup(0x281), 0);
+    CHECK(!map.assign(CanIdMap::ID_COUNT, 0));
+    CHECK(!map.assign(0x300, CanIdMap::NONE));
+    CHECK_EQ(map.lookup(0x1FFFFFFF), CanIdMap::NONE);
+
+    CHECK(map.assign(0x7FF, 14));
+    CHECK_EQ(map.lookup(0x7FF), 14);
+
+    map.clear();
+    CHECK_EQ(map.lookup(0x280), CanIdMap::NONE);
+    CHECK_EQ(map.lookup(0x7FF), CanIdMap::NONE);
+    return TEST_RESULT();
+}
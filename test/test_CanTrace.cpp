@@ -0,0 +1,73 @@
+#include "TestCheck.h"
+#include "CanTrace.h"
+
+static void compactFormat() {
+    CANMessage msg;
+    CHECK(CanTrace::parseCandumpLine("281#2C01323204000010", msg));
+    CHECK_EQ(msg.id, 0x281u);
+    CHECK(!msg.ext);
+    CHECK_EQ(msg.len, 8);
+    CHECK_EQ(msg.data[0], 0x2C);
+    CHECK_EQ(msg.data[7], 0x10);
+
+    // candump -L: Zeitstempel und Interface davor, Kleinbuchstaben
+    CHECK(CanTrace::parseCandumpLine("(1700000000.123456) can0 283#012c01\n", msg));
+    CHECK_EQ(msg.id, 0x283u);
+    CHECK_EQ(msg.len, 3);
+    CHECK_EQ(msg.data[1], 0x2C);
+    CHECK_EQ(msg.data[3], 0);
+
+    // Ohne Daten und mit erweiterter ID
+    CHECK(CanTrace::parseCandumpLine("281#", msg));
+    CHECK_EQ(msg.len, 0);
+    CHECK(CanTrace::parseCandumpLine("18FF0281#01", msg));
+    CHECK(msg.ext);
+    CHECK_EQ(msg.id, 0x18FF0281u);
+}
+
+static void standardFormat() {
+    CANMessage msg;
+    CHECK(CanTrace::parseCandumpLine("  can0  281   [8]  2C 01 32 32 04 00 00 10", msg));
+    CHECK_EQ(msg.id, 0x281u);
+    CHECK(!msg.ext);
+    CHECK_EQ(msg.len, 8);
+    CHECK_EQ(msg.data[1], 0x01);
+    CHECK_EQ(msg.data[4], 0x04);
+
+    // Weniger Bytes als 8, Tabulatoren
+    CHECK(CanTrace::parseCandumpLine("can1\t283\t[2]\tFF 0a", msg));
+    CHECK_EQ(msg.id, 0x283u);
+    CHECK_EQ(msg.len, 2);
+    CHECK_EQ(msg.data[1], 0x0A);
+}
+
+static void invalidLines() {
+    CANMessage msg;
+    CHECK(!CanTrace::parseCandumpLine("", msg));
+    CHECK(!CanTrace::parseCandumpLine("   \n", msg));
+    CHECK(!CanTrace::parseCandumpLine("can0", msg));
+    CHECK(!CanTrace::parseCandumpLine("# Kommentar", msg));
+    CHECK(!CanTrace::parseCandumpLine("281#2C0", msg));              // halbes Byte
+    CHECK(!CanTrace::parseCandumpLine("can0  281   [8", msg));       // ohne ]
+    CHECK(!CanTrace::parseCandumpLine("can0  281   [1]  2", msg));   // halbes Byte
+}
+
+static void sampleTrace() {
+    // Der Referenz-Trace enthält nur Frames im Standardformat mit 8 Byte
+    CHECK(CanTrace::SAMPLE_COUNT > 0);
+    CANMessage msg;
+    for (uint8_t f = 0; f < CanTrace::SAMPLE_COUNT; f++) {
+        CanTrace::toMessage(CanTrace::SAMPLE[f], msg);
+        CHECK_EQ(msg.id, CanTrace::SAMPLE[f].id);
+        CHECK(!msg.ext && !msg.rtr);
+        CHECK_EQ(msg.len, 8);
+    }
+}
+
+int main() {
+    compactFormat();
+    standardFormat();
+    invalidLines();
+    sampleTrace();
+    return TEST_RESULT();
+}
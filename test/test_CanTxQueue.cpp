@@ -0,0 +1,122 @@
+#include "TestCheck.h"
+#include "CanTxQueue.h"
+
+static CANMessage frame(uint32_t id, uint8_t value) {
+    CANMessage msg;
+    msg.id = id;
+    msg.len = 1;
+    msg.data[0] = value;
+    return msg;
+}
+
+static void priorityOrder() {
+    CanTxQueue queue;
+    queue.begin(1000, 3);
+    CHECK(queue.push(frame(0x300, 1), 0, 1, 1, 2));
+    CHECK(queue.push(frame(0x301, 2), 0, 2, 2, 0));
+    CHECK(queue.push(frame(0x302, 3), 1, 1, 3, 1));
+    CHECK_EQ(queue.queued(), 3);
+
+    uint8_t index = queue.next(0);
+    CHECK_EQ(queue.entry(index).msg.id, 0x301);
+    queue.sent(index, 0);
+    // Unterwegs: der nächste Eintrag nach Priorität
+    index = queue.next(0);
+    CHECK_EQ(queue.entry(index).msg.id, 0x302);
+    queue.sent(index, 0);
+    index = queue.next(0);
+    CHECK_EQ(queue.entry(index).msg.id, 0x300);
+    queue.sent(index, 0);
+    CHECK_EQ(queue.inFlight(), 3);
+    CHECK_EQ(queue.next(0), CanTxQueue::NONE);
+}
+
+static void replaceAndAcknowledge() {
+    CanTxQueue queue;
+    queue.begin(1000, 3);
+    queue.push(frame(0x301, 10), 0, 1, 10, 0);
+    uint8_t index = queue.next(0);
+    queue.sent(index, 0);
+    CHECK_EQ(queue.inFlight(), 1);
+
+    // Neuer Sollwert für denselben Kanal und Befehl ersetzt den gesendeten
+    CHECK(queue.push(frame(0x301, 20), 0, 1, 20, 0));
+    CHECK_EQ(queue.queued(), 1);
+    CHECK_EQ(queue.inFlight(), 0);
+    index = queue.next(10);
+    CHECK_EQ(queue.entry(index).value, 20);
+    queue.sent(index, 10);
+
+    // Gleicher Befehl auf einem anderen Kanal ist ein eigener Eintrag
+    queue.push(frame(0x311, 30), 1, 1, 30, 0);
+    CHECK_EQ(queue.queued(), 2);
+
+    // Quittung entfernt nur den passenden Eintrag
+    for (uint8_t i = 0; i < CanTxQueue::capacity(); i++) {
+        const CanTxQueue::Entry &entry = queue.entry(i);
+        if (entry.used && entry.inFlight && entry.channel == 0 && entry.value == 20)
+            queue.acknowledge(i);
+    }
+    CHECK_EQ(queue.acknowledged(), 1);
+    CHECK_EQ(queue.queued(), 1);
+    CHECK_EQ(queue.inFlight(), 0);
+    index = queue.next(20);
+    CHECK_EQ(queue.entry(index).channel, 1);
+}
+
+static void retryUntilExhausted() {
+    CanTxQueue queue;
+    queue.begin(500, 3);
+    queue.push(frame(0x301, 1), 0, 1, 1, 0);
+    uint32_t now = 0;
+    for (uint8_t attempt = 1; attempt <= 3; attempt++) {
+        const uint8_t index = queue.next(now);
+        CHECK(index != CanTxQueue::NONE);
+        if (index == CanTxQueue::NONE) return;
+        queue.sent(index, now);
+        CHECK_EQ(queue.entry(index).attempts, attempt);
+        CHECK_EQ(queue.nextDeadline(), now + 500);
+        // Vor dem Timeout keine Wiederholung
+        CHECK_EQ(queue.next(now + 499), CanTxQueue::NONE);
+        now += 500;
+    }
+    // Nach dem dritten Versuch ohne Quittung verworfen
+    CHECK_EQ(queue.next(now), CanTxQueue::NONE);
+    CHECK_EQ(queue.retries(), 2);
+    CHECK_EQ(queue.failed(), 1);
+    CHECK(queue.idle());
+    CHECK_EQ(queue.inFlight(), 0);
+}
+
+static void driverBusy() {
+    // Treiber voll: Eintrag bleibt ohne Versuch stehen und kommt wieder
+    CanTxQueue queue;
+    queue.begin(500, 1);
+    queue.push(frame(0x301, 1), 0, 1, 1, 0);
+    const uint8_t index = queue.next(0);
+    CHECK_EQ(queue.next(100), index);
+    CHECK_EQ(queue.entry(index).attempts, 0);
+    CHECK_EQ(queue.failed(), 0);
+}
+
+static void fullQueue() {
+    CanTxQueue queue;
+    queue.begin(500, 3);
+    for (uint8_t i = 0; i < CanTxQueue::capacity(); i++)
+        CHECK(queue.push(frame(0x300 + i, i), i, 0, i, 1));
+    CHECK(!queue.push(frame(0x3FF, 0), 0xFE, 0, 0, 0));
+    CHECK_EQ(queue.dropped(), 1);
+    CHECK_EQ(queue.queued(), CanTxQueue::capacity());
+    // Ersetzen geht auch bei voller Warteschlange
+    CHECK(queue.push(frame(0x300, 99), 0, 0, 99, 1));
+    CHECK_EQ(queue.dropped(), 1);
+}
+
+int main() {
+    priorityOrder();
+    replaceAndAcknowledge();
+    retryUntilExhausted();
+    driverBusy();
+    fullQueue();
+    return TEST_RESULT();
+}
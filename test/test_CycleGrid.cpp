@@ -0,0 +1,44 @@
+#include "TestCheck.h"
+#include "CycleGrid.h"
+
+static void gridPoints() {
+    const uint32_t cycle = CycleGrid::cycleMs(5);
+    CHECK_EQ(cycle, 300000);
+    CHECK_EQ(CycleGrid::next(0, 1000, cycle), 1000);
+    CHECK_EQ(CycleGrid::next(1000, 1000, cycle), 1000);
+    CHECK_EQ(CycleGrid::next(1001, 1000, cycle), 301000);
+    // Vor dem Überlauf von millis(): Termin danach, höchstens ein Zyklus entfernt
+    const uint32_t late = CycleGrid::next(0xFFFFF000u, 1000, cycle);
+    CHECK((int32_t)(late - 0xFFFFF000u) >= 0);
+    CHECK(late - 0xFFFFF000u < cycle);
+}
+
+static void lateLoopKeepsGrid() {
+    // Der Loop sendet 40 ms nach dem Rasterpunkt: der nächste Rasterpunkt
+    // bleibt der Folgetermin, es wird kein Zyklus übersprungen
+    const uint32_t cycle = CycleGrid::cycleMs(1);
+    const uint32_t phase = 5000;
+    uint32_t deadline = CycleGrid::next(0, phase, cycle);
+    for (uint8_t i = 0; i < 10; i++) {
+        const uint32_t sentAt = deadline + 40;
+        const uint32_t following = CycleGrid::next(CycleGrid::afterSend(sentAt, 1), phase, cycle);
+        CHECK_EQ(following, deadline + cycle);
+        deadline = following;
+    }
+}
+
+static void phasesSpread() {
+    // Positionen verteilen sich gleichmäßig, der Geräteversatz verschiebt alle
+    const uint32_t cycle = CycleGrid::cycleMs(2);
+    CHECK_EQ(CycleGrid::phase(0, 0, 4, cycle), 0);
+    CHECK_EQ(CycleGrid::phase(0, 1, 4, cycle), 30000);
+    CHECK_EQ(CycleGrid::phase(0, 3, 4, cycle), 90000);
+    CHECK_EQ(CycleGrid::phase(100000, 1, 4, cycle), 10000);
+}
+
+int main() {
+    gridPoints();
+    lateLoopKeepsGrid();
+    phasesSpread();
+    return TEST_RESULT();
+}
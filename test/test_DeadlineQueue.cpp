@@ -0,0 +1,58 @@
+#include "TestCheck.h"
+#include "DeadlineQueue.h"
+
+static void ordering() {
+    DeadlineQueue<8> queue;
+    queue.schedule(3, 300);
+    queue.schedule(1, 100);
+    queue.schedule(5, 500);
+    queue.schedule(2, 200);
+    CHECK(!queue.due(99));
+    CHECK(queue.due(100));
+    CHECK_EQ(queue.pop(), 1);
+    CHECK_EQ(queue.pop(), 2);
+    CHECK_EQ(queue.pop(), 3);
+    CHECK_EQ(queue.pop(), 5);
+    CHECK(queue.empty());
+}
+
+static void rescheduleAndCancel() {
+    DeadlineQueue<8> queue;
+    queue.schedule(0, 100);
+    queue.schedule(1, 200);
+    queue.schedule(2, 300);
+    queue.schedule(2, 50);      // vorziehen
+    queue.schedule(0, 400);     // verschieben
+    queue.cancel(1);
+    CHECK(!queue.scheduled(1));
+    CHECK_EQ(queue.next(), 50);
+    CHECK_EQ(queue.pop(), 2);
+    CHECK_EQ(queue.pop(), 0);
+    CHECK(queue.empty());
+    queue.cancel(1);            // ohne Termin: keine Wirkung
+    CHECK(queue.empty());
+}
+
+static void wrapAround() {
+    // Termine über den Überlauf von millis() hinweg
+    DeadlineQueue<4> queue;
+    queue.schedule(0, 0xFFFFFF00u);
+    queue.schedule(1, 0x00000100u);
+    CHECK_EQ(queue.pop(), 0);
+    CHECK(!queue.due(0xFFFFFFF0u));
+    CHECK(queue.due(0x00000100u));
+
+    // Kleiner Zeittyp
+    DeadlineQueue<4, uint16_t> coarse;
+    coarse.schedule(0, 0xFFF0);
+    coarse.schedule(1, 0x0010);
+    CHECK_EQ(coarse.pop(), 0);
+    CHECK_EQ(coarse.pop(), 1);
+}
+
+int main() {
+    ordering();
+    rescheduleAndCancel();
+    wrapAround();
+    return TEST_RESULT();
+}
@@ -0,0 +1,93 @@
+#include "TestCheck.h"
+#include "KnxSendScheduler.h"
+
+static void priorityOrder() {
+    KnxSendScheduler scheduler;
+    scheduler.begin(10, 10);
+    scheduler.request(5, SendPriority::Statistic);
+    scheduler.request(7, SendPriority::Status);
+    scheduler.request(3, SendPriority::Alarm);
+    CHECK_EQ(scheduler.queued(), 3);
+    CHECK_EQ(scheduler.next(0), 3);
+    CHECK_EQ(scheduler.next(0), 7);
+    CHECK_EQ(scheduler.next(0), 5);
+    CHECK_EQ(scheduler.next(0), KnxSendScheduler::NONE);
+    CHECK(scheduler.idle());
+    CHECK_EQ(scheduler.sent(), 3);
+}
+
+static void coalesceAndPromote() {
+    KnxSendScheduler scheduler;
+    scheduler.begin(10, 10);
+    scheduler.request(9, SendPriority::Statistic);
+    scheduler.request(4, SendPriority::Status);
+    // Erneuter Wunsch: kein zweites Telegramm, aber hochgestuft
+    scheduler.request(9, SendPriority::Alarm);
+    // Niedrigere Priorität stuft nicht herab
+    scheduler.request(4, SendPriority::Statistic);
+    CHECK_EQ(scheduler.queued(), 2);
+    CHECK_EQ(scheduler.coalesced(), 2);
+    CHECK_EQ(scheduler.next(0), 9);
+    CHECK_EQ(scheduler.next(0), 4);
+}
+
+static void rateLimit() {
+    KnxSendScheduler scheduler;
+    scheduler.begin(2, 1);      // 2/s, kein Burst
+    for (uint8_t i = 0; i < 4; i++) scheduler.request(i, SendPriority::Status);
+    CHECK_EQ(scheduler.next(1000), 0);
+    CHECK_EQ(scheduler.next(1000), KnxSendScheduler::NONE);
+    CHECK_EQ(scheduler.next(1499), KnxSendScheduler::NONE);
+    CHECK_EQ(scheduler.next(1500), 1);
+    CHECK_EQ(scheduler.next(2000), 2);
+}
+
+static void holdAfterStart() {
+    KnxSendScheduler scheduler;
+    scheduler.begin(10, 5);
+    scheduler.hold(5000);
+    scheduler.request(1, SendPriority::Status);
+    scheduler.request(2, SendPriority::Status);
+    CHECK_EQ(scheduler.next(4999), KnxSendScheduler::NONE);
+    // Nach dem Anlauf beginnt der Bucket leer, kein Burst
+    CHECK_EQ(scheduler.next(5000), KnxSendScheduler::NONE);
+    CHECK_EQ(scheduler.next(5100), 1);
+    CHECK_EQ(scheduler.next(5100), KnxSendScheduler::NONE);
+}
+
+static void beyond64() {
+    KnxSendScheduler scheduler;
+    scheduler.begin(255, 255);
+    scheduler.request(KnxSendScheduler::CAPACITY - 1, SendPriority::Status);
+    scheduler.request(70, SendPriority::Status);
+    scheduler.request(63, SendPriority::Status);
+    CHECK_EQ(scheduler.queued(), 3);
+    CHECK_EQ(scheduler.next(0), 63);
+    CHECK_EQ(scheduler.next(0), 70);
+    CHECK_EQ(scheduler.next(0), KnxSendScheduler::CAPACITY - 1);
+    CHECK(scheduler.idle());
+}
+
+static void refillAfterLongIdle() {
+    // elapsed * rate läuft über 2^32 (hier auf 254), der Bucket muss trotzdem voll sein
+    KnxSendScheduler scheduler;
+    scheduler.begin(255, 3);
+    for (uint8_t i = 0; i < 3; i++) scheduler.request(i, SendPriority::Status);
+    for (uint8_t i = 0; i < 3; i++) CHECK_EQ(scheduler.next(0), i);
+    const uint32_t later = 16843010;
+    for (uint8_t i = 0; i < 4; i++) scheduler.request(i, SendPriority::Status);
+    CHECK_EQ(scheduler.next(later), 0);
+    CHECK_EQ(scheduler.next(later), 1);
+    CHECK_EQ(scheduler.next(later), 2);
+    CHECK_EQ(scheduler.next(later), KnxSendScheduler::NONE);
+}
+
+int main() {
+    priorityOrder();
+    coalesceAndPromote();
+    rateLimit();
+    holdAfterStart();
+    beyond64();
+    refillAfterLongIdle();
+    return TEST_RESULT();
+}
@@ -0,0 +1,83 @@
+#include "TestCheck.h"
+#include "LEDAProtocol.h"
+
+static CANMessage frame(uint32_t id, uint8_t len, const uint8_t (&bytes)[8]) {
+    CANMessage msg;
+    msg.id = id;
+    msg.len = len;
+    for (uint8_t i = 0; i < 8; i++) msg.data[i] = bytes[i];
+    return msg;
+}
+
+static void status281() {
+    Data data = DEFAULT_VALUES;
+    FrameUpdate update = {};
+    // 300 °C, Klappe 50/50, Status 4 (Heizbetrieb), Version 16
+    CHECK(LEDAProtocol::parseFrame(frame(0x281, 8, {0x2C, 0x01, 50, 50, 4, 0, 0, 16}), data, &update));
+    CHECK_EQ(data.combustion_temp.value, 300);
+    CHECK_EQ(data.air_flap_act.value, 50);
+    CHECK_EQ(data.oven_state_num.value, 4);
+    CHECK_EQ(data.controller_version.value, 16);
+    CHECK(update.present & DataField::bit(DataField::CombustionTemp));
+    CHECK(update.changed & DataField::bit(DataField::OvenStateNum));
+    CHECK(data.valid & DataField::bit(DataField::OvenStateText));
+    CHECK(data.oven_state_text != nullptr);
+
+    // Gleicher Frame: enthalten, aber nichts geändert
+    CHECK(LEDAProtocol::parseFrame(frame(0x281, 8, {0x2C, 0x01, 50, 50, 4, 0, 0, 16}), data, &update));
+    CHECK_EQ(update.changed, 0);
+
+    // Negative Temperatur (Little-Endian, vorzeichenbehaftet)
+    CHECK(LEDAProtocol::parseFrame(frame(0x281, 8, {0xF6, 0xFF, 50, 50, 4, 0, 0, 16}), data, &update));
+    CHECK_EQ(data.combustion_temp.value, -10);
+}
+
+static void subtypes283() {
+    Data data = DEFAULT_VALUES;
+    CHECK(LEDAProtocol::parseFrame(frame(0x283, 7, {1, 0x20, 0x03, 0x64, 0x00, 0xFE, 7, 0}), data));
+    CHECK_EQ(data.max_combustion_temp.value, 800);
+    CHECK_EQ(data.smoldering_temp.value, 100);
+    CHECK_EQ(data.trend.value, -2);
+
+    CHECK(LEDAProtocol::parseFrame(frame(0x283, 7, {2, 0, 0, 0x10, 0x00, 3, 0, 0}), data));
+    CHECK_EQ(data.burn_cycles.value, 16);
+    CHECK_EQ(data.heating_error_count.value, 3);
+}
+
+static void rejects() {
+    Data data = DEFAULT_VALUES;
+    // Unbekannte ID und unbekannter Subtyp
+    CHECK(!LEDAProtocol::parseFrame(frame(0x123, 8, {}), data));
+    CHECK(!LEDAProtocol::parseFrame(frame(0x283, 8, {9}), data));
+    // 0x283 ohne Typ-Byte und zu kurze Frames ändern nichts
+    CHECK(!LEDAProtocol::parseFrame(frame(0x283, 0, {1, 0x20, 0x03}), data));
+    CHECK(!LEDAProtocol::parseFrame(frame(0x283, 4, {1, 0x20, 0x03, 0x64}), data));
+    CHECK(!LEDAProtocol::parseFrame(frame(0x281, 7, {0x2C, 0x01, 50, 50, 4, 0, 0}), data));
+    CHECK_EQ(data.valid, 0);
+    CHECK_EQ(data.max_combustion_temp.value, -1000);
+
+    // Remote-Frames auf bekannten IDs überschreiben keine Werte
+    CANMessage remote = frame(0x281, 8, {});
+    remote.rtr = true;
+    CHECK(!LEDAProtocol::parseFrame(remote, data));
+    remote.id = 0x283;
+    remote.data[0] = 1;
+    CHECK(!LEDAProtocol::parseFrame(remote, data));
+    CHECK_EQ(data.valid, 0);
+    CHECK_EQ(data.combustion_temp.value, -1000);
+    CHECK_EQ(data.oven_state_num.value, 255);
+}
+
+static void decodedIds() {
+    CHECK_EQ(LEDAProtocol::decodedIdCount(), 2);
+    CHECK_EQ(LEDAProtocol::decodedId(0), 0x281);
+    CHECK_EQ(LEDAProtocol::decodedId(1), 0x283);
+}
+
+int main() {
+    status281();
+    subtypes283();
+    rejects();
+    decodedIds();
+    return TEST_RESULT();
+}
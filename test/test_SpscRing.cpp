@@ -0,0 +1,63 @@
+#include "TestCheck.h"
+#include "SpscRing.h"
+#include <thread>
+
+static void fifo() {
+    SpscRing<uint32_t, 4> ring;
+    CHECK(ring.empty());
+    for (uint32_t i = 0; i < 4; i++) CHECK(ring.push(i));
+    CHECK(!ring.push(99));
+    CHECK_EQ(ring.overflows(), 1);
+    CHECK_EQ(ring.highWater(), 4);
+    CHECK_EQ(ring.freeSpace(), 0);
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < 4; i++) {
+        CHECK(ring.pop(value));
+        CHECK_EQ(value, i);
+    }
+    CHECK(!ring.pop(value));
+}
+
+static void indexWrap() {
+    // Über den Überlauf der 16-Bit-Indizes hinaus
+    SpscRing<uint16_t, 8> ring;
+    uint16_t value = 0;
+    for (uint32_t i = 0; i < 70000; i++) {
+        CHECK(ring.push((uint16_t)i));
+        CHECK(ring.pop(value));
+        if (value != (uint16_t)i) {
+            CHECK_EQ(value, (uint16_t)i);
+            break;
+        }
+    }
+    CHECK(ring.empty());
+}
+
+static void twoThreads() {
+    // Erzeuger und Verbraucher auf verschiedenen Threads (wie Core 1 / Core 0)
+    static SpscRing<uint32_t, 64> ring;
+    constexpr uint32_t COUNT = 100000;
+    std::thread producer([] {
+        for (uint32_t i = 0; i < COUNT; i++)
+            while (!ring.push(i)) std::this_thread::yield();
+    });
+    uint32_t expected = 0;
+    uint32_t value = 0;
+    while (expected < COUNT) {
+        if (!ring.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value != expected) break;
+        expected++;
+    }
+    producer.join();
+    CHECK_EQ(expected, COUNT);
+}
+
+int main() {
+    fifo();
+    indexWrap();
+    twoThreads();
+    return TEST_RESULT();
+}
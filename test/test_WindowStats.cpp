@@ -0,0 +1,56 @@
+#include "TestCheck.h"
+#include "WindowStats.h"
+
+static void constantValue() {
+    WindowStats stats;
+    stats.begin(0);
+    stats.add(20, 0);
+    const WindowResult result = stats.close(60000);
+    CHECK(result.valid);
+    CHECK_NEAR(result.mean, 20, 1e-4);
+    CHECK_NEAR(result.slopePerMinute, 0, 1e-4);
+    CHECK_EQ(result.min, 20);
+    CHECK_EQ(result.max, 20);
+}
+
+static void timeWeighted() {
+    // 10 s lang 100, dann ein Schauer von Frames mit 0 innerhalb 10 ms, dann 50 s lang 0
+    WindowStats stats;
+    stats.setThreshold(50);
+    stats.begin(0);
+    stats.add(100, 0);
+    for (uint32_t t = 10000; t < 10010; t++) stats.add(0, t);
+    const WindowResult result = stats.close(60000);
+    CHECK_NEAR(result.mean, 100.0 * 10 / 60, 0.01);
+    CHECK_EQ(result.secondsAbove, 10);
+    CHECK_EQ(result.min, 0);
+    CHECK_EQ(result.max, 100);
+}
+
+static void rampSlope() {
+    // 0,05 K/s über 15 Minuten, ein Sample je Sekunde, Werte nahe 600 °C
+    WindowStats stats;
+    stats.begin(0);
+    for (uint32_t s = 0; s < 900; s++) stats.add(600 + 0.05f * s, s * 1000);
+    const WindowResult result = stats.close(900000);
+    CHECK_NEAR(result.slopePerMinute, 3.0, 0.01);
+}
+
+static void carriesOver() {
+    // Der letzte Wert gilt im nächsten Fenster weiter, ein leeres Fenster ist ungültig
+    WindowStats stats;
+    CHECK(!stats.close(1000).valid);
+    stats.add(42, 1000);
+    stats.close(2000);
+    const WindowResult next = stats.close(3000);
+    CHECK(next.valid);
+    CHECK_NEAR(next.mean, 42, 1e-4);
+}
+
+int main() {
+    constantValue();
+    timeWeighted();
+    rampSlope();
+    carriesOver();
+    return TEST_RESULT();
+}
@@ -0,0 +1,114 @@
+/**
+ * @brief Host-Tool: wertet eine CAN-Aufzeichnung (/leda/capture.bin) aus.
+ *
+ * Die Datei wird per mmap als Array von CanCaptureFormat::Page gelesen, die
+ * gültigen Seiten nach sequence sortiert und jeder Datensatz wie auf dem Gerät
+ * ("leda analyze capture") über LEDAProtocol::parseFrame in den
+ * UnknownByteAnalyzer gespeist. Ausgabe wie showAnalysis() plus Durchsatz.
+ *
+ * Aufruf: LedaCaptureAnalyze <capture.bin> [ID-Versatz des Kanals]
+ */
+#include "CanCapture.h"
+#include "LEDAProtocol.h"
+#include "UnknownByteAnalyzer.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace CanCaptureFormat;
+
+static void showAnalysis(const UnknownByteAnalyzer &analyzer) {
+    printf("Unbekannte Bytes (%u Statuswechsel, Korrelation in %%):\n", analyzer.transitions());
+    printf("  %-9s %8s %6s %5s %5s %6s %6s %6s %6s\n", "Byte", "Samples", "Wechs%", "Werte", "Häuf.",
+           UnknownByteAnalyzer::referenceName(UnknownByteAnalyzer::RefCombustionTemp),
+           UnknownByteAnalyzer::referenceName(UnknownByteAnalyzer::RefAirFlapAct),
+           UnknownByteAnalyzer::referenceName(UnknownByteAnalyzer::RefOvenStateNum), "StatW%");
+    for (uint8_t i = 0; i < UnknownByteAnalyzer::UNKNOWN_COUNT; i++) {
+        const UnknownByteAnalyzer::ByteStats &s = analyzer.stats(i);
+        const uint32_t samples = s.samples ? s.samples : 1;
+        const uint32_t changes = s.changes ? s.changes : 1;
+        printf("  %-9s %8u %6u %5u %5u %6d %6d %6d %6u\n", UnknownByteAnalyzer::name(i), s.samples,
+               (uint32_t)((uint64_t)s.changes * 100 / samples), analyzer.distinctValues(i), analyzer.mostFrequent(i),
+               analyzer.correlation(i, UnknownByteAnalyzer::RefCombustionTemp),
+               analyzer.correlation(i, UnknownByteAnalyzer::RefAirFlapAct),
+               analyzer.correlation(i, UnknownByteAnalyzer::RefOvenStateNum),
+               (uint32_t)((uint64_t)s.transitionChanges * 100 / changes));
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Aufruf: %s <capture.bin> [ID-Versatz]\n", argv[0]);
+        return 2;
+    }
+    const uint16_t idOffset = (argc > 2) ? (uint16_t)strtoul(argv[2], nullptr, 0) : 0;
+
+    const int fd = open(argv[1], O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    const size_t pageCount = st.st_size / PAGE_SIZE;
+    if (pageCount == 0) {
+        fprintf(stderr, "%s: keine vollständige Seite\n", argv[1]);
+        return 1;
+    }
+    void *mapped = mmap(nullptr, pageCount * PAGE_SIZE, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    const Page *pages = (const Page *)mapped;
+
+    // Ring: nach dem Umlauf stehen die ältesten Seiten nicht am Dateianfang
+    std::vector<const Page *> order;
+    for (size_t i = 0; i < pageCount; i++)
+        if (valid(pages[i])) order.push_back(&pages[i]);
+    std::sort(order.begin(), order.end(), [](const Page *a, const Page *b) {
+        return a->header.sequence < b->header.sequence;
+    });
+
+    Data data = DEFAULT_VALUES;
+    UnknownByteAnalyzer *analyzer = new UnknownByteAnalyzer();
+    analyzer->reset();
+    uint32_t records = 0;
+    uint32_t decoded = 0;
+    uint32_t firstMillis = 0;
+    uint32_t lastMillis = 0;
+
+    const auto started = std::chrono::steady_clock::now();
+    for (const Page *page : order) {
+        forEachRecord(*page, [&](uint32_t millis, const Record &record) {
+            if (records++ == 0) firstMillis = millis;
+            lastMillis = millis;
+            CANMessage msg;
+            CanCapture::toMessage(record, msg);
+            if (msg.ext) return;
+            msg.id -= idOffset;
+            FrameUpdate update;
+            if (LEDAProtocol::parseFrame(msg, data, &update)) {
+                analyzer->update(data, update.present, update.changed, millis);
+                decoded++;
+            }
+        });
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    printf("%zu Seiten (%zu gültig), %u Frames, %u dekodiert, %.1f s Aufzeichnung\n", pageCount, order.size(), records,
+           decoded, (lastMillis - firstMillis) / 1000.0);
+    if (records > 0)
+        printf("Auswertung: %.0f ns/Frame\n", seconds * 1e9 / records);
+    showAnalysis(*analyzer);
+
+    delete analyzer;
+    munmap(mapped, pageCount * PAGE_SIZE);
+    return 0;
+}
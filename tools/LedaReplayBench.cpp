@@ -0,0 +1,137 @@
+/**
+ * @brief Host-Tool: spielt einen candump-Trace durch das komplette Gateway.
+ *
+ * Die Frames laufen wie auf dem Gerät über CANInterface (Ersatz unter
+ * test/stubs) in CANGateway::loop(): processFrame mit LEDAProtocol::parseFrame,
+ * Übergabe an die KNX-Seite, syncDataToKNX und die Sendewarteschlange. Die KOs
+ * sind Ersatzobjekte, gezählt werden die tatsächlich gesendeten Telegramme.
+ *
+ * Senden bei Änderung ist für alle Felder eingeschaltet, sonst gelten die
+ * ETS-Vorgaben. Die Zeit kommt aus den Zeitstempeln von candump -L, fehlen
+ * sie, liegen die Frames 10 ms auseinander.
+ *
+ * Aufruf: LedaReplayBench [trace.log] [Wiederholungen]
+ * Ohne Datei (oder "-") wird der eingebaute Referenz-Trace genutzt.
+ */
+#include "CANGatewayModule.h"
+#include "CanTrace.h"
+#include "HostCanInterface.h"
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Ohne Zeitstempel: Abstand zwischen zwei Frames
+static constexpr uint32_t FRAME_STEP_MS = 10;
+// Beginn der Wiedergabe nach Startverzögerung und Geräteversatz (höchstens 10 s)
+static constexpr uint32_t REPLAY_START_MS = 20000;
+
+struct TraceEntry {
+    CANMessage msg;
+    uint32_t at;    // ms seit dem ersten Frame
+};
+
+/**
+ * @brief Liest den Zeitstempel "(1700000000.123456)" am Zeilenanfang.
+ */
+static bool readTimestamp(const char *line, double &seconds) {
+    while (*line == ' ' || *line == '\t') line++;
+    if (*line != '(') return false;
+    char *end;
+    seconds = strtod(line + 1, &end);
+    return end != line + 1 && *end == ')';
+}
+
+static bool loadTrace(const char *path, std::vector<TraceEntry> &trace) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+    char line[256];
+    uint32_t lineNumber = 0;
+    double first = -1;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        TraceEntry entry;
+        if (!CanTrace::parseCandumpLine(line, entry.msg)) {
+            if (line[strspn(line, " \t\r\n")] != '\0')
+                fprintf(stderr, "%s:%u: kein Frame, übersprungen\n", path, lineNumber);
+            continue;
+        }
+        double seconds;
+        if (readTimestamp(line, seconds)) {
+            if (first < 0) first = seconds;
+            entry.at = (uint32_t)((seconds - first) * 1000);
+        } else {
+            entry.at = trace.empty() ? 0 : trace.back().at + FRAME_STEP_MS;
+        }
+        trace.push_back(entry);
+    }
+    fclose(file);
+    return true;
+}
+
+static void loadSample(std::vector<TraceEntry> &trace) {
+    for (uint8_t f = 0; f < CanTrace::SAMPLE_COUNT; f++) {
+        TraceEntry entry;
+        CanTrace::toMessage(CanTrace::SAMPLE[f], entry.msg);
+        entry.at = f * FRAME_STEP_MS;
+        trace.push_back(entry);
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *path = (argc > 1 && strcmp(argv[1], "-") != 0) ? argv[1] : nullptr;
+    const uint32_t repeat = (argc > 2) ? (uint32_t)strtoul(argv[2], nullptr, 0) : 1;
+
+    std::vector<TraceEntry> trace;
+    if (path) {
+        if (!loadTrace(path, trace)) return 1;
+    } else {
+        loadSample(trace);
+    }
+    if (trace.empty() || repeat == 0) {
+        fprintf(stderr, "Keine Frames\n");
+        return 1;
+    }
+
+    Param_CombTempSendChg_1 = 1;
+    Param_MaxCombTempSendChg_1 = 1;
+    Param_SmoldTempSendChg_1 = 1;
+    Param_AirActSendChg_1 = 1;
+    Param_AirTrgSendChg_1 = 1;
+
+    openknx.logger.quiet = true;
+    CANGateway *gateway = new CANGateway();
+    hostSetMillis(0);
+    gateway->setup();
+
+    const uint32_t period = trace.back().at + FRAME_STEP_MS;
+    const uint32_t telegramsBefore = GroupObject::sentTotal;
+    uint64_t frames = 0;
+    uint32_t now = REPLAY_START_MS;
+
+    const auto started = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < repeat; r++) {
+        const uint32_t base = REPLAY_START_MS + r * period;
+        for (const TraceEntry &entry : trace) {
+            now = base + entry.at;
+            hostSetMillis(now);
+            hostCanReceive(entry.msg);
+            gateway->loop();
+            frames++;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    const uint32_t telegrams = GroupObject::sentTotal - telegramsBefore;
+
+    printf("%zu Frames im Trace, %u Durchläufe, %.1f s Busbetrieb\n", trace.size(), repeat,
+           (now - REPLAY_START_MS) / 1000.0);
+    printf("%.0f Frames/s\n", frames / seconds);
+    printf("%.0f ns/Frame\n", seconds * 1e9 / frames);
+    printf("%u KNX-Telegramme\n", telegrams);
+
+    delete gateway;
+    return 0;
+}